@@ -101,6 +101,7 @@ i32 app_load_task(app_load_s *l, i32 state)
     case __LINE__: app_load_tex_new(l, TEXID_DISPLAY_TMP, 400, 240, 0); break;
     case __LINE__: app_load_tex_new(l, TEXID_DISPLAY_TMP_MASK, 400, 240, 0); break;
     case __LINE__: app_load_tex_new(l, TEXID_DISPLAY_WHITE_OUTLINED, 400, 240, 1); break;
+    case __LINE__: tex_dirty_track(asset_tex(TEXID_DISPLAY_WHITE_OUTLINED)); break;
     case __LINE__: app_load_tex(l, TEXID_HERO, "T_HERO"); break;
     case __LINE__: app_load_tex(l, TEXID_ROTOR, "T_ROTOR"); break;
     case __LINE__: app_load_tex(l, TEXID_FLSURF, "T_FLSURF"); break;
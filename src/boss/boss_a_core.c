@@ -34,7 +34,7 @@ obj_s *boss_a_core_create(g_s *g, boss_a_s *b, v2_i32 p_anchor)
     o->heap               = game_alloc_roomt(g, boss_a_core_s);
     boss_a_core_s *c      = (boss_a_core_s *)o->heap;
     c->b                  = b;
-    o->ID                 = 4000;
+    o->ID                 = OBJID_BOSS_A_CORE;
     o->w                  = 32;
     o->h                  = 32;
     // o->flags              = OBJ_FLAG_HURT_ON_TOUCH;
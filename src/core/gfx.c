@@ -10,6 +10,37 @@
 #include "util/sorting.h"
 #include "util/str.h"
 
+#define GFX_NUM_DIRTY 2
+
+typedef struct {
+    u32 *px; // pixels of the tracked texture
+    i16  x1; // dirty bounds inclusive; x2 < x1 if clean
+    i16  y1;
+    i16  x2;
+    i16  y2;
+} gfx_dirty_s;
+
+static gfx_dirty_s g_gfx_dirty[GFX_NUM_DIRTY];
+
+// called by the blitters with already clipped bounds
+static inline void gfx_dirty_mark(tex_s t, i32 x1, i32 y1, i32 x2, i32 y2)
+{
+    for (i32 n = 0; n < GFX_NUM_DIRTY; n++) {
+        gfx_dirty_s *d = &g_gfx_dirty[n];
+        if (d->px != t.px) continue;
+
+        if (d->x2 < d->x1) {
+            d->x1 = x1, d->y1 = y1, d->x2 = x2, d->y2 = y2;
+        } else {
+            d->x1 = min_i32(d->x1, x1);
+            d->y1 = min_i32(d->y1, y1);
+            d->x2 = max_i32(d->x2, x2);
+            d->y2 = max_i32(d->y2, y2);
+        }
+        return;
+    }
+}
+
 #define SPRBLIT_FUNCNAME gfx_spr_d_s
 #define SPRBLIT_SRC_MASK 0
 #define SPRBLIT_DST_MASK 0
@@ -402,19 +433,31 @@ void tex_merge_to_opaque(tex_s dst, tex_s src)
 }
 
 void tex_merge_to_opaque_outlined_white(tex_s dst, tex_s src)
+{
+    rec_i32 r = {0, 0, src.w, src.h};
+    tex_merge_to_opaque_outlined_white_rec(dst, src, r);
+}
+
+void tex_merge_to_opaque_outlined_white_rec(tex_s dst, tex_s src, rec_i32 r)
 {
     assert(dst.fmt == TEX_FMT_OPAQUE);
     assert(src.fmt == TEX_FMT_MASK);
     assert(dst.wword * 2 == src.wword && dst.h == src.h);
+    if (r.w <= 0 || r.h <= 0) return;
 
-    u32 *d = dst.px;
-    u32 *s = src.px;
+    // outline reaches one pixel into the surrounding area
+    i32 y1 = max_i32(r.y - 1, 0);
+    i32 y2 = min_i32(r.y + r.h, src.h - 1);
+    i32 x1 = max_i32(r.x - 1, 0) >> 5;
+    i32 x2 = min_i32(r.x + r.w, src.w - 1) >> 5;
 
-    for (i32 y = 0; y < src.h; y++) {
-        i32 yi1 = y == 0 ? 0 : -1;
-        i32 yi2 = y == src.h - 1 ? 0 : +1;
+    for (i32 y = y1; y <= y2; y++) {
+        i32  yi1 = y == 0 ? 0 : -1;
+        i32  yi2 = y == src.h - 1 ? 0 : +1;
+        u32 *d   = &dst.px[y * dst.wword + x1];
+        u32 *s   = &src.px[y * src.wword + (x1 << 1)];
 
-        for (i32 x = 0; x < src.wword; x += 2) {
+        for (i32 x = x1 << 1; x <= (x2 << 1); x += 2) {
             u32 sp = *(s + 0);
             u32 sm = *(s + 1);
 
@@ -459,6 +502,92 @@ void tex_merge_to_opaque_outlined_white(tex_s dst, tex_s src)
     }
 }
 
+void tex_clr_rec(tex_s dst, rec_i32 r, i32 col)
+{
+    if (!dst.px) return;
+
+    i32 y1 = max_i32(r.y, 0);
+    i32 y2 = min_i32(r.y + r.h - 1, dst.h - 1);
+    i32 x1 = max_i32(r.x, 0) >> 5;
+    i32 x2 = min_i32(r.x + r.w - 1, dst.w - 1) >> 5;
+    if (r.w <= 0 || y2 < y1 || x2 < x1) return;
+
+    i32 lsh = dst.fmt == TEX_FMT_MASK;
+    u32 vp  = col == GFX_COL_WHITE ? 0xFFFFFFFFU : 0;
+    u32 vm  = col == GFX_COL_CLEAR ? 0 : 0xFFFFFFFFU;
+
+    for (i32 y = y1; y <= y2; y++) {
+        u32 *p = &dst.px[y * dst.wword + (x1 << lsh)];
+
+        for (i32 x = x1; x <= x2; x++) {
+            switch (dst.fmt) {
+            case TEX_FMT_OPAQUE:
+                if (col != GFX_COL_CLEAR) {
+                    *p = vp;
+                }
+                p++;
+                break;
+            case TEX_FMT_MASK:
+                if (col != GFX_COL_CLEAR) {
+                    *p = vp;
+                }
+                *(p + 1) = vm;
+                p += 2;
+                break;
+            }
+        }
+    }
+}
+
+void tex_dirty_track(tex_s t)
+{
+    gfx_dirty_s *d = 0;
+    for (i32 n = 0; n < GFX_NUM_DIRTY; n++) {
+        gfx_dirty_s *k = &g_gfx_dirty[n];
+        if (k->px == t.px) {
+            d = k;
+            break;
+        }
+        if (!d && !k->px) {
+            d = k;
+        }
+    }
+    assert(d);
+    if (!d) return;
+
+    d->px = t.px;
+    d->x1 = 0;
+    d->y1 = 0;
+    d->x2 = t.w - 1;
+    d->y2 = t.h - 1;
+}
+
+void tex_dirty_reset(tex_s t)
+{
+    for (i32 n = 0; n < GFX_NUM_DIRTY; n++) {
+        gfx_dirty_s *d = &g_gfx_dirty[n];
+        if (d->px == t.px) {
+            d->x1 = 1;
+            d->x2 = 0;
+        }
+    }
+}
+
+rec_i32 tex_dirty_rec(tex_s t)
+{
+    rec_i32 r = {0};
+    for (i32 n = 0; n < GFX_NUM_DIRTY; n++) {
+        gfx_dirty_s *d = &g_gfx_dirty[n];
+        if (d->px == t.px && d->x1 <= d->x2) {
+            r.x = d->x1;
+            r.y = d->y1;
+            r.w = d->x2 - d->x1 + 1;
+            r.h = d->y2 - d->y1 + 1;
+        }
+    }
+    return r;
+}
+
 gfx_ctx_s gfx_ctx_from_tex(tex_s dst)
 {
     gfx_ctx_s c = {0};
@@ -676,14 +805,6 @@ typedef struct {
     u8            doff; // bitoffset of first dst bit
 } span_blit_s;
 
-static span_blit_s span_blit_change_y(span_blit_s s, i32 y)
-{
-    span_blit_s r = s;
-    r.dp          = s.dp + (y - s.y) * s.dst_wword;
-    r.y           = y;
-    return r;
-}
-
 static span_blit_s span_blit_gen(gfx_ctx_s ctx, i32 y, i32 x1, i32 x2, i32 mode)
 {
     i32         nbit = (x2 + 1) - x1; // number of bits in a row to blit
@@ -824,7 +945,8 @@ void gfx_rec_fill(gfx_ctx_s ctx, rec_i32 rec, i32 mode)
     i32 y1 = max_i32(rec.y, ctx.clip_y1);
     i32 x2 = min_i32(rec.x + rec.w - 1, ctx.clip_x2);
     i32 y2 = min_i32(rec.y + rec.h - 1, ctx.clip_y2);
-    if (x2 < x1) return;
+    if (x2 < x1 || y2 < y1) return;
+    gfx_dirty_mark(ctx.dst, x1, y1, x2, y2);
 
     tex_s       dtex = ctx.dst;
     span_blit_s info = span_blit_gen(ctx, y1, x1, x2, mode);
@@ -850,7 +972,8 @@ void gfx_rec_fill_opaque(gfx_ctx_s ctx, rec_i32 rec, i32 mode)
     i32 y1 = max_i32(rec.y, ctx.clip_y1);
     i32 x2 = min_i32(rec.x + rec.w - 1, ctx.clip_x2);
     i32 y2 = min_i32(rec.y + rec.h - 1, ctx.clip_y2);
-    if (x2 < x1) return;
+    if (x2 < x1 || y2 < y1) return;
+    gfx_dirty_mark(ctx.dst, x1, y1, x2, y2);
 
     span_blit_s info = span_blit_gen(ctx, y1, x1, x2, mode);
     for (i32 y = y1; y <= y2; y++) {
@@ -859,11 +982,96 @@ void gfx_rec_fill_opaque(gfx_ctx_s ctx, rec_i32 rec, i32 mode)
     }
 }
 
+// sets pixels [a, b] in a row of words starting at pixel w1 << 5
+// bit 31 is the leftmost pixel, swapped to memory order when blitting
+static void gfx_row_mask_span(u32 *m, i32 w1, i32 a, i32 b)
+{
+    i32 k1 = (a >> 5) - w1;
+    i32 k2 = (b >> 5) - w1;
+    u32 ml = 0xFFFFFFFFU >> (a & 31);
+    u32 mr = 0xFFFFFFFFU << (31 - (b & 31));
+    if (k1 == k2) {
+        m[k1] |= ml & mr;
+        return;
+    }
+    m[k1] |= ml;
+    for (i32 k = k1 + 1; k < k2; k++) {
+        m[k] = 0xFFFFFFFFU;
+    }
+    m[k2] |= mr;
+}
+
+void gfx_fill_columns_opaque(gfx_ctx_s ctx, i32 x, i32 cw, const i16 *top, i32 n, i32 y2, i32 mode)
+{
+    tex_s dtex = ctx.dst;
+    assert(dtex.fmt == TEX_FMT_OPAQUE);
+    if (n <= 0 || cw <= 0) return;
+
+    i32 top_min = top[0];
+    i32 top_max = top[0];
+    for (i32 i = 1; i < n; i++) {
+        top_min = min_i32(top_min, top[i]);
+        top_max = max_i32(top_max, top[i]);
+    }
+
+    i32 x1 = max_i32(x, ctx.clip_x1);
+    i32 x2 = min_i32(x + n * cw - 1, ctx.clip_x2);
+    i32 y1 = max_i32(top_min, ctx.clip_y1);
+    i32 yb = min_i32(y2, ctx.clip_y2);
+    if (x2 < x1 || yb < y1) return;
+    gfx_dirty_mark(ctx.dst, x1, y1, x2, yb);
+
+    // rows at or below the lowest column top are covered completely:
+    // a plain span; rows above get a mask of the columns reaching them
+    i32 y_full = max_i32(top_max, y1);
+    if (y_full <= yb) {
+        span_blit_s info = span_blit_gen(ctx, y_full, x1, x2, mode);
+        for (i32 y = y_full; y <= yb; y++) {
+            prim_blit_span_X(info);
+            span_blit_incr_y(&info);
+        }
+    }
+
+    i32 w1 = x1 >> 5;
+    i32 nw = (x2 >> 5) - w1 + 1;
+    spm_push();
+    u32 *m = spm_alloctn(u32, nw);
+
+    for (i32 y = y1; y < y_full && y <= yb; y++) {
+        mclr(m, sizeof(u32) * nw);
+        for (i32 i = 0; i < n; i++) {
+            if (y < top[i]) continue;
+
+            // merge runs of neighbouring columns into one span
+            i32 i2 = i;
+            while (i2 + 1 < n && top[i2 + 1] <= y) {
+                i2++;
+            }
+            i32 a = max_i32(x + i * cw, x1);
+            i32 b = min_i32(x + (i2 + 1) * cw - 1, x2);
+            if (a <= b) {
+                gfx_row_mask_span(m, w1, a, b);
+            }
+            i = i2;
+        }
+
+        u32 *dp = &dtex.px[w1 + y * dtex.wword];
+        u32  pt = ctx.pat.p[y & 7];
+        for (i32 k = 0; k < nw; k++) {
+            if (m[k]) {
+                apply_prim_mode_X(&dp[k], bswap32(m[k]), mode, pt);
+            }
+        }
+    }
+    spm_pop();
+}
+
 void gfx_rec_strip(gfx_ctx_s ctx, i32 rx, i32 ry, i32 rw, i32 mode)
 {
     i32 x1 = max_i32(rx, ctx.clip_x1); // area bounds on canvas [x1/y1, x2/y2]
     i32 x2 = min_i32(rx + rw - 1, ctx.clip_x2);
     if (x2 < x1 || ry < ctx.clip_y1 || ry > ctx.clip_y2) return;
+    gfx_dirty_mark(ctx.dst, x1, ry, x2, ry);
 
     tex_s       dtex = ctx.dst;
     span_blit_s info = span_blit_gen(ctx, ry, x1, x2, mode);
@@ -900,6 +1108,7 @@ void gfx_rec_rounded_fill(gfx_ctx_s ctx, rec_i32 rec, i32 r, i32 mode)
 void gfx_fill_rows(tex_s dst, gfx_pattern_s pat, i32 y1, i32 y2)
 {
     assert(0 <= y1 && y2 < dst.h);
+    gfx_dirty_mark(dst, 0, y1, dst.w - 1, y2);
     u32 *px = &dst.px[y1 * dst.wword];
     for (i32 y = y1; y <= y2; y++) {
         u32 p = ~pat.p[y & 7];
@@ -931,72 +1140,154 @@ void fnt_draw_str(gfx_ctx_s ctx, fnt_s fnt, v2_i32 pos, const void *s, i32 mode)
     }
 }
 
-void fnt_draw_outline_style(gfx_ctx_s ctx, fnt_s f, v2_i32 pos, const void *str, i32 style, b32 centeredx)
+#define FNT_STYLE_TEXW     320
+#define FNT_STYLE_TEXH     40
+#define FNT_STYLE_WWORD    ((FNT_STYLE_TEXW >> 5) << 1)
+#define FNT_RUN_NUM        12
+#define FNT_RUN_STR_LEN    64
+#define FNT_RUN_DRAW_FIRST 4 // draw offset of the first glyph
+
+// cached outlined text run
+typedef struct {
+    u32 *fnt_px; // identifies the font
+    u32  hash;
+    u32  used; // eviction age; 0 if free
+    u16  w;    // width in px containing all opaque pixels
+    u8   style;
+    u8   len;
+    u8   str[FNT_RUN_STR_LEN];
+    u32  px[FNT_STYLE_WWORD * FNT_STYLE_TEXH];
+} fnt_run_s;
+
+static fnt_run_s g_fnt_runs[FNT_RUN_NUM];
+static u32       g_fnt_runs_tick;
+
+// renders a styled text run into a cleared 320x40 mask texture
+static void fnt_outline_style_render(tex_s t, fnt_s f, const void *str, i32 style)
 {
-    assert(f.t.px);
-    assert(ctx.dst.px);
-#define FNT_STYLE_TEXW 320
-#define FNT_STYLE_TEXH 40
-    TEX_STACK_CTX(textmp, FNT_STYLE_TEXW, FNT_STYLE_TEXH, 1);
+    gfx_ctx_s ctx = gfx_ctx_from_tex(t);
+    v2_i32    pos = {FNT_RUN_DRAW_FIRST, FNT_RUN_DRAW_FIRST};
 
     switch (style) {
     case 0: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, SPR_MODE_INV);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 1);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 0);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 1);
+        fnt_draw_str(ctx, f, pos, str, SPR_MODE_INV);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 1);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 0);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 1);
         break;
     }
     case 1: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, 0);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 1);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 0);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 1);
+        fnt_draw_str(ctx, f, pos, str, 0);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 1);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 0);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 1);
         break;
     }
     case 2: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, 0);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 1);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 0);
-        // tex_outline_col_ext_small(textmp, GFX_COL_BLACK, 1);
+        fnt_draw_str(ctx, f, pos, str, 0);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 1);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 0);
+        // tex_outline_col_ext_small(t, GFX_COL_BLACK, 1);
         break;
     }
     case 3: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, 0);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 1);
+        fnt_draw_str(ctx, f, pos, str, 0);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 1);
         break;
     }
     case 4: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, SPR_MODE_INV);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 1);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 0);
+        fnt_draw_str(ctx, f, pos, str, SPR_MODE_INV);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 1);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 0);
         break;
     }
     case 5: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, 0);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 1);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 1);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 0);
+        fnt_draw_str(ctx, f, pos, str, 0);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 1);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 1);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 0);
         break;
     }
     case 6: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, SPR_MODE_INV);
+        fnt_draw_str(ctx, f, pos, str, SPR_MODE_INV);
         break;
     }
     case 7: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, 0);
+        fnt_draw_str(ctx, f, pos, str, 0);
         break;
     }
     case 8: {
-        fnt_draw_str(textmp_ctx, f, (v2_i32){4, 4}, str, 0);
-        tex_outline_col_ext(textmp, GFX_COL_WHITE, 1);
-        tex_outline_col_ext(textmp, GFX_COL_BLACK, 1);
+        fnt_draw_str(ctx, f, pos, str, 0);
+        tex_outline_col_ext(t, GFX_COL_WHITE, 1);
+        tex_outline_col_ext(t, GFX_COL_BLACK, 1);
         break;
     }
     }
+}
+
+// returns a cached run, renders it on a miss
+// returns null if the string is too long to be cached
+static fnt_run_s *fnt_run_get(fnt_s f, const void *str, i32 style)
+{
+    i32 len = str_len(str);
+    if (FNT_RUN_STR_LEN <= len) return 0;
+
+    u32        h   = hash_str(str);
+    fnt_run_s *run = &g_fnt_runs[0];
+    g_fnt_runs_tick++;
+
+    for (i32 n = 0; n < FNT_RUN_NUM; n++) {
+        fnt_run_s *k = &g_fnt_runs[n];
+        if (k->used && k->hash == h && k->fnt_px == f.t.px &&
+            k->style == style && k->len == len && str_eq(k->str, str)) {
+            k->used = g_fnt_runs_tick;
+            return k;
+        }
+        if (k->used < run->used) {
+            run = k;
+        }
+    }
+
+    // evict the oldest run
+    tex_s t     = {run->px, FNT_STYLE_TEXW, FNT_STYLE_TEXH, FNT_STYLE_WWORD, TEX_FMT_MASK};
+    run->fnt_px = f.t.px;
+    run->hash   = h;
+    run->used   = g_fnt_runs_tick;
+    run->style  = style;
+    run->len    = len;
+    str_cpy(run->str, str);
+    mclr(run->px, sizeof(run->px));
+    fnt_outline_style_render(t, f, str, style);
+
+    // trim to the right most word containing opaque pixels
+    i32 wmax = 0;
+    for (i32 n = 1; n < FNT_STYLE_WWORD * FNT_STYLE_TEXH; n += 2) {
+        if (run->px[n]) {
+            wmax = max_i32(wmax, 1 + ((n % FNT_STYLE_WWORD) >> 1));
+        }
+    }
+    run->w = wmax << 5;
+    return run;
+}
+
+void fnt_draw_outline_style(gfx_ctx_s ctx, fnt_s f, v2_i32 pos, const void *str, i32 style, b32 centeredx)
+{
+    assert(f.t.px);
+    assert(ctx.dst.px);
+
+    i32    px = centeredx ? fnt_length_px(f, str) : 0;
+    v2_i32 p  = {pos.x - FNT_RUN_DRAW_FIRST - (px >> 1), pos.y - 2};
 
-    i32 px = centeredx ? fnt_length_px(f, str) : 0;
-    gfx_spr(ctx, texrec_from_tex(textmp), (v2_i32){pos.x - 4 - (px >> 1), pos.y - 2}, 0, 0);
+    fnt_run_s *run = fnt_run_get(f, str, style);
+    if (run) {
+        tex_s    t  = {run->px, FNT_STYLE_TEXW, FNT_STYLE_TEXH, FNT_STYLE_WWORD, TEX_FMT_MASK};
+        texrec_s tr = {t, 0, 0, run->w, FNT_STYLE_TEXH};
+        gfx_spr(ctx, tr, p, 0, 0);
+    } else {
+        TEX_STACK(textmp, FNT_STYLE_TEXW, FNT_STYLE_TEXH, 1);
+        fnt_outline_style_render(textmp, f, str, style);
+        gfx_spr(ctx, texrec_from_tex(textmp), p, 0, 0);
+    }
 }
 
 i32 fnt_length_px(fnt_s fnt, const void *txt)
@@ -1048,6 +1339,7 @@ void gfx_tri_fill(gfx_ctx_s ctx, tri_i32 t, i32 mode)
         x1 = max_i32(x1, ctx.clip_x1);
         x2 = min_i32(x2, ctx.clip_x2);
         if (x2 < x1) continue;
+        gfx_dirty_mark(ctx.dst, x1, y, x2, y);
         span_blit_s info = span_blit_gen(ctx, y, x1, x2, mode);
         prim_blit_span(info);
     }
@@ -1063,6 +1355,7 @@ void gfx_tri_fill(gfx_ctx_s ctx, tri_i32 t, i32 mode)
         x1 = max_i32(x1, ctx.clip_x1);
         x2 = min_i32(x2, ctx.clip_x2);
         if (x2 < x1) continue;
+        gfx_dirty_mark(ctx.dst, x1, y, x2, y);
         span_blit_s info = span_blit_gen(ctx, y, x1, x2, mode);
         prim_blit_span(info);
     }
@@ -1124,63 +1417,36 @@ void gfx_tri_fill_uvw(gfx_ctx_s ctx, v2_i32 tri[3], i32 mode)
             w += wx;
         }
 
-        span_blit_s i = span_blit_gen(ctx, y, x1, x2, mode);
-        prim_blit_span(i);
+        if (x1 <= x2) {
+            gfx_dirty_mark(ctx.dst, x1, y, x2, y);
+            span_blit_s i = span_blit_gen(ctx, y, x1, x2, mode);
+            prim_blit_span(i);
+        }
         u0 -= uy;
         v0 -= vy;
         w0 -= wy;
     }
 }
 
-void gfx_cir_fill(gfx_ctx_s ctx, v2_i32 p, i32 d, i32 mode)
-{
-    if (d <= 0) return;
+#define GFX_CIR_SPAN_D_MAX   128 // largest diameter with a cached span table
+#define GFX_CIR_SPAN_OFFS(D) ((D) + (((D) - 1) * ((D) - 1)) / 4)
 
-    i32 r = d >> 1;
-    if (d <= 2) {
-        rec_i32 rec = {p.x - r, p.y - r, d, d};
-        gfx_rec_fill(ctx, rec, mode);
-        return;
-    }
-
-    rec_i32 rb = {p.x - r - 1, p.y - r - 1, d + 1, d + 1};
-    rec_i32 rt = {ctx.clip_x1, ctx.clip_y1,
-                  ctx.clip_x2 - ctx.clip_x1, ctx.clip_y2 - ctx.clip_y1};
-    if (!overlap_rec(rb, rt)) return;
+// half widths k of every row t of a filled circle of diameter d:
+// rows p.y - t and p.y + t + (d & 1) span [p.x - k, p.x + k + (d & 1)]
+static u16 g_cir_span[GFX_CIR_SPAN_OFFS(GFX_CIR_SPAN_D_MAX + 1)];
+static u32 g_cir_span_built[(GFX_CIR_SPAN_D_MAX + 32) >> 5];
 
+// walks the midpoint circle once and keeps the widest span of every row
+static void gfx_cir_span_walk(i32 d, u16 *k)
+{
     i32 e = -d + (d == 3 ? +1 : -1);
-    i32 x = r; // radius
+    i32 x = d >> 1;
     i32 y = 0;
-    i32 m = (d & 1 ? +1 : 0);
+    mclr(k, sizeof(u16) * (x + 1));
 
     while (y <= x) {
-        i32 ax0 = max_i32(p.x - x, ctx.clip_x1);
-        i32 cx0 = max_i32(p.x - y, ctx.clip_x1);
-        i32 ax1 = min_i32(p.x + x + m, ctx.clip_x2);
-        i32 cx1 = min_i32(p.x + y + m, ctx.clip_x2);
-
-        if (cx0 <= cx1) {
-            i32         cy = p.y + x + m;
-            i32         dy = p.y - x;
-            span_blit_s sc = span_blit_gen(ctx, cy, cx0, cx1, mode);
-            if (ctx.clip_y1 <= cy && cy <= ctx.clip_y2) {
-                prim_blit_span(sc);
-            }
-            if (ctx.clip_y1 <= dy && dy <= ctx.clip_y2) {
-                prim_blit_span(span_blit_change_y(sc, dy));
-            }
-        }
-        if (ax0 <= ax1) {
-            i32         ay = p.y + y + m;
-            i32         by = p.y - y;
-            span_blit_s sa = span_blit_gen(ctx, ay, ax0, ax1, mode);
-            if (ctx.clip_y1 <= ay && ay <= ctx.clip_y2) {
-                prim_blit_span(sa);
-            }
-            if (ctx.clip_y1 <= by && by <= ctx.clip_y2 && ay != by) {
-                prim_blit_span(span_blit_change_y(sa, by));
-            }
-        }
+        k[x] = max_i32(k[x], y);
+        k[y] = max_i32(k[y], x);
 
         e += y << 1;
         y++;
@@ -1193,6 +1459,74 @@ void gfx_cir_fill(gfx_ctx_s ctx, v2_i32 p, i32 d, i32 mode)
     }
 }
 
+// returns the cached span table of a diameter, built on first use
+static const u16 *gfx_cir_spans(i32 d)
+{
+    assert(3 <= d && d <= GFX_CIR_SPAN_D_MAX);
+    u16 *k = &g_cir_span[GFX_CIR_SPAN_OFFS(d)];
+    if (!(g_cir_span_built[d >> 5] & ((u32)1 << (d & 31)))) {
+        g_cir_span_built[d >> 5] |= (u32)1 << (d & 31);
+        gfx_cir_span_walk(d, k);
+    }
+    return k;
+}
+
+static void gfx_span_fill(gfx_ctx_s ctx, i32 y, i32 x1, i32 x2, i32 mode)
+{
+    span_blit_s info = span_blit_gen(ctx, y, x1, x2, mode);
+    if (ctx.dst.fmt == TEX_FMT_OPAQUE) {
+        prim_blit_span_X(info);
+    } else {
+        prim_blit_span_Y(info);
+    }
+}
+
+static void gfx_cir_fill_spans(gfx_ctx_s ctx, v2_i32 p, i32 d, const u16 *k, i32 mode)
+{
+    i32 r  = d >> 1;
+    i32 m  = d & 1;
+    i32 y1 = max_i32(p.y - r, ctx.clip_y1);
+    i32 y2 = min_i32(p.y + r + m, ctx.clip_y2);
+    gfx_dirty_mark(ctx.dst,
+                   max_i32(p.x - r, ctx.clip_x1), y1,
+                   min_i32(p.x + r + m, ctx.clip_x2), y2);
+
+    for (i32 y = y1; y <= y2; y++) {
+        i32 t  = y <= p.y ? p.y - y : y - p.y - m;
+        i32 x1 = max_i32(p.x - k[t], ctx.clip_x1);
+        i32 x2 = min_i32(p.x + k[t] + m, ctx.clip_x2);
+        if (x1 <= x2) {
+            gfx_span_fill(ctx, y, x1, x2, mode);
+        }
+    }
+}
+
+void gfx_cir_fill(gfx_ctx_s ctx, v2_i32 p, i32 d, i32 mode)
+{
+    if (d <= 0) return;
+
+    i32 r = d >> 1;
+    if (d <= 2) {
+        rec_i32 rec = {p.x - r, p.y - r, d, d};
+        gfx_rec_fill(ctx, rec, mode);
+        return;
+    }
+
+    i32 m = d & 1;
+    if (p.y + r + m < ctx.clip_y1 || ctx.clip_y2 < p.y - r ||
+        p.x + r + m < ctx.clip_x1 || ctx.clip_x2 < p.x - r) return;
+
+    if (d <= GFX_CIR_SPAN_D_MAX) {
+        gfx_cir_fill_spans(ctx, p, d, gfx_cir_spans(d), mode);
+    } else {
+        spm_push();
+        u16 *k = spm_alloctn(u16, r + 1);
+        gfx_cir_span_walk(d, k);
+        gfx_cir_fill_spans(ctx, p, d, k, mode);
+        spm_pop();
+    }
+}
+
 typedef struct {
     ALIGNAS(4)
     u16 x1;
@@ -1274,6 +1608,7 @@ void gfx_lin_thick(gfx_ctx_s ctx, v2_i32 a, v2_i32 b, i32 mode, i32 d)
         x1 = max_i32(x1 / GFX_LIN_THICK_SUBPX, ctx.clip_x1);
         x2 = min_i32(x2 / GFX_LIN_THICK_SUBPX, ctx.clip_x2);
         if (x1 <= x2) {
+            gfx_dirty_mark(ctx.dst, x1, yi_px, x2, yi_px);
             prim_blit_span(span_blit_gen(ctx, yi_px, x1, x2, mode));
         }
     }
@@ -1332,6 +1667,64 @@ void gfx_spr(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, i32 flip, i32 mode)
     }
 }
 
+ATTRIBUTE_SECTION(".text.spr")
+void gfx_spr_shear_x(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, i32 shear_q8, i32 mode)
+{
+    if (!src.t.px) return;
+    assert(src.t.fmt == TEX_FMT_MASK);
+    assert(ctx.dst.fmt == TEX_FMT_OPAQUE);
+
+    i32 y1 = max_i32(ctx.clip_y1, pos.y);
+    i32 y2 = min_i32(ctx.clip_y2, pos.y + src.h - 1);
+    if (y2 < y1) return; // not visible
+
+    tex_s t_d = ctx.dst;
+    tex_s t_s = src.t;
+    i32   bx1 = I32_MAX; // touched columns of all rows for dirty marking
+    i32   bx2 = I32_MIN;
+
+    for (i32 y_d = y1; y_d <= y2; y_d++) {
+        i32 i  = y_d - pos.y;
+        i32 px = pos.x + ((shear_q8 * (src.h - 1 - i)) >> 8);
+        i32 x1 = max_i32(ctx.clip_x1, px);
+        i32 x2 = min_i32(ctx.clip_x2, px + src.w - 1);
+        if (x2 < x1) continue;
+        bx1 = min_i32(bx1, x1);
+        bx2 = max_i32(bx2, x2);
+
+        i32  a_x = src.x - px;
+        i32  shl = 31 & (u32)(a_x);
+        i32  shr = 32 - shl;
+        u32  c_m = bswap32(0xFFFFFFFF >> (31 & x1));
+        u32  c_r = bswap32(0xFFFFFFFF << (31 - (x2 & 31)));
+        i32  dw1 = x1 >> 5;
+        i32  dw2 = x2 >> 5;
+        u32 *s_r = &t_s.px[(src.y + i) * t_s.wword];
+        u32 *d_r = &t_d.px[y_d * t_d.wword];
+        u32  pat = ctx.pat.p[y_d & 7];
+
+        for (i32 d_w = dw1; d_w <= dw2; d_w++, c_m = 0xFFFFFFFF) {
+            i32 sx1 = max_i32(a_x + (d_w << 5), 0);
+            i32 sx2 = min_i32(a_x + (d_w << 5) + 31, t_s.w - 1);
+            if (d_w == dw2) {
+                c_m &= c_r;
+            }
+
+            u32 sp1 = bswap32(s_r[((sx1 >> 5) << 1) + 0]);
+            u32 sp2 = bswap32(s_r[((sx2 >> 5) << 1) + 0]);
+            u32 sm1 = bswap32(s_r[((sx1 >> 5) << 1) + 1]);
+            u32 sm2 = bswap32(s_r[((sx2 >> 5) << 1) + 1]);
+            u32 spp = bswap32((u32)((u64)sp1 << shl) | (u32)((u64)sp2 >> shr));
+            u32 smm = c_m & bswap32((u32)((u64)sm1 << shl) | (u32)((u64)sm2 >> shr));
+            spr_blit_p(&d_r[d_w], spp, smm, pat, mode);
+        }
+    }
+
+    if (bx1 <= bx2) {
+        gfx_dirty_mark(t_d, bx1, y1, bx2, y2);
+    }
+}
+
 static inline void spr_blit_tile(u32 *dp, u32 sp, u32 sm)
 {
     *dp = (*dp & ~sm) | (sp & sm); // copy
@@ -1353,6 +1746,7 @@ void gfx_spr_tile_32x32(gfx_ctx_s ctx, texrec_s src, v2_i32 pos)
     i32 x2 = min_i32(pos.x + src.w - 1, ctx.clip_x2);
     i32 y2 = min_i32(pos.y + src.h - 1, ctx.clip_y2);
     if (x2 < x1 || y2 < y1) return; // clip, not visible
+    gfx_dirty_mark(ctx.dst, x1, y1, x2, y2);
 
     i32  nb = x2 - x1 + 1;                                    // number of bits in a row
     i32  od = x1 & 31;                                        // bitoffset in dst
@@ -1387,33 +1781,92 @@ void gfx_spr_tile_32x32(gfx_ctx_s ctx, texrec_s src, v2_i32 pos)
     } while (sp <= sp_end_incl);
 }
 
-static void gfx_fill_circle_segment_span(gfx_ctx_s ctx, i32 y, i32 x1, i32 x2, v2_i32 p, v2_i32 a, v2_i32 b, i32 w, i32 mode)
+static inline i32 gfx_div_floor(i32 n, i32 d)
 {
-    b32 inside = 0;
-    i32 xi     = 0;
+    assert(0 < d);
+    return (0 <= n ? n / d : -((-n + d - 1) / d));
+}
 
-    for (i32 x = x1; x <= x2; x++) {
-        v2_i32 s = {x - p.x, y - p.y};
-        i32    u = v2_i32_crs(a, s);
-        i32    v = v2_i32_crs(b, s);
+// range [*x1, *x2] of all sx satisfying c0 + c1 * sx >= 0
+static void gfx_halfline(i32 c0, i32 c1, i32 *x1, i32 *x2)
+{
+    *x1 = -0xFFFF;
+    *x2 = +0xFFFF;
+    if (0 < c1) {
+        *x1 = -gfx_div_floor(c0, c1);
+    } else if (c1 < 0) {
+        *x2 = gfx_div_floor(c0, -c1);
+    } else if (c0 < 0) {
+        *x1 = 1, *x2 = 0;
+    }
+}
 
-        if ((0 <= w && (0 <= u && v <= 0)) ||
-            (0 >= w && (0 <= u || v <= 0))) {
-            if (!inside) {
-                inside = 1;
-                xi     = x;
-            }
-        } else {
-            if (inside) {
-                inside = 0;
-                gfx_rec_strip(ctx, xi, y, x - xi, mode);
+// disjoint, sorted ranges of sx in row sy counter clockwise between a and b
+// returns the number of ranges in r[0..1] - r[2..3]
+static i32 gfx_cir_seg_ranges(i32 sy, v2_i32 a, v2_i32 b, i32 w, i32 *r)
+{
+    // u = crs(a, s) >= 0, v = crs(b, s) <= 0
+    i32 u1, u2, v1, v2;
+    gfx_halfline(+i32_mul(a.x, sy), -a.y, &u1, &u2);
+    gfx_halfline(-i32_mul(b.x, sy), +b.y, &v1, &v2);
+
+    if (0 < w) { // inside both
+        r[0] = max_i32(u1, v1);
+        r[1] = min_i32(u2, v2);
+        return (r[0] <= r[1]);
+    }
+
+    // inside either one
+    if (u2 < u1) {
+        r[0] = v1, r[1] = v2;
+        return (v1 <= v2);
+    }
+    if (v2 < v1) {
+        r[0] = u1, r[1] = u2;
+        return 1;
+    }
+    if (v1 < u1) {
+        SWAP(i32, u1, v1);
+        SWAP(i32, u2, v2);
+    }
+    if (v1 <= u2 + 1) {
+        r[0] = u1, r[1] = max_i32(u2, v2);
+        return 1;
+    }
+    r[0] = u1, r[1] = u2, r[2] = v1, r[3] = v2;
+    return 2;
+}
+
+// fills all ranges a (na) intersected with ranges b (nb) and [x1, x2] in row y
+static void gfx_span_fill_ranges(gfx_ctx_s ctx, i32 y, i32 x1, i32 x2, i32 px,
+                                 const i32 *a, i32 na, const i32 *b, i32 nb, i32 mode)
+{
+    for (i32 i = 0; i < na; i++) {
+        for (i32 j = 0; j < nb; j++) {
+            i32 s1 = max_i32(max_i32(a[i * 2 + 0], b[j * 2 + 0]) + px, x1);
+            i32 s2 = min_i32(min_i32(a[i * 2 + 1], b[j * 2 + 1]) + px, x2);
+            if (s1 <= s2) {
+                gfx_dirty_mark(ctx.dst, s1, y, s2, y);
+                gfx_span_fill(ctx, y, s1, s2, mode);
             }
         }
     }
+}
+
+static void gfx_cir_seg_fill_spans(gfx_ctx_s ctx, v2_i32 p, i32 d, const u16 *k, v2_i32 a, v2_i32 b, i32 w, i32 mode)
+{
+    i32 r  = d >> 1;
+    i32 m  = d & 1;
+    i32 y1 = max_i32(p.y - r, ctx.clip_y1);
+    i32 y2 = min_i32(p.y + r + m, ctx.clip_y2);
 
-    // if still inside draw remaining widest strip up to x2
-    if (inside) {
-        gfx_rec_strip(ctx, xi, y, x2 - xi, mode);
+    for (i32 y = y1; y <= y2; y++) {
+        i32 t     = y <= p.y ? p.y - y : y - p.y - m;
+        i32 x2    = min_i32(p.x + k[t] + m, ctx.clip_x2) - 1; // the right most pixel is left out
+        i32 rc[2] = {-k[t], k[t] + m};
+        i32 rs[4];
+        i32 ns = gfx_cir_seg_ranges(y - p.y, a, b, w, rs);
+        gfx_span_fill_ranges(ctx, y, ctx.clip_x1, x2, p.x, rc, 1, rs, ns, mode);
     }
 }
 
@@ -1427,52 +1880,42 @@ void gfx_fill_circle_segment(gfx_ctx_s ctx, v2_i32 p, i32 d, i32 a1_q18, i32 a2_
     rec_i32 rt = {ctx.clip_x1, ctx.clip_y1, ctx.clip_x2 - ctx.clip_x1, ctx.clip_y2 - ctx.clip_y1};
     if (!overlap_rec(rb, rt)) return;
 
-    i32 e = -d + (d == 3 ? +1 : -1);
-    i32 x = r; // radius
-    i32 y = 0;
-    i32 m = (d & 1 ? +1 : 0);
-
     // >> 2 -> avoid overflow during multiplication
     v2_i32 a = {sin_q16(a1_q18) >> 4, cos_q16(a1_q18) >> 4};
     v2_i32 b = {sin_q16(a2_q18) >> 4, cos_q16(a2_q18) >> 4};
     i32    w = v2_i32_crs(a, b);
 
-    while (y <= x) {
-        i32 ax0 = max_i32(p.x - x, ctx.clip_x1);
-        i32 cx0 = max_i32(p.x - y, ctx.clip_x1);
-        i32 ax1 = min_i32(p.x + x + m, ctx.clip_x2);
-        i32 cx1 = min_i32(p.x + y + m, ctx.clip_x2);
-
-        if (cx0 <= cx1) {
-            i32 cy = p.y + x + m;
-            i32 dy = p.y - x;
-            if (ctx.clip_y1 <= cy && cy <= ctx.clip_y2) {
-                gfx_fill_circle_segment_span(ctx, cy, cx0, cx1, p, a, b, w, mode);
-            }
-            if (ctx.clip_y1 <= dy && dy <= ctx.clip_y2) {
-                gfx_fill_circle_segment_span(ctx, dy, cx0, cx1, p, a, b, w, mode);
-            }
-        }
-        if (ax0 <= ax1) {
-            i32 ay = p.y + y + m;
-            i32 by = p.y - y;
-            if (ctx.clip_y1 <= ay && ay <= ctx.clip_y2) {
-                gfx_fill_circle_segment_span(ctx, ay, ax0, ax1, p, a, b, w, mode);
-            }
-            if (ctx.clip_y1 <= by && by <= ctx.clip_y2 && ay != by) {
-                gfx_fill_circle_segment_span(ctx, by, ax0, ax1, p, a, b, w, mode);
-            }
-        }
+    if (d <= GFX_CIR_SPAN_D_MAX) {
+        gfx_cir_seg_fill_spans(ctx, p, d, gfx_cir_spans(d), a, b, w, mode);
+    } else {
+        spm_push();
+        u16 *k = spm_alloctn(u16, r + 1);
+        gfx_cir_span_walk(d, k);
+        gfx_cir_seg_fill_spans(ctx, p, d, k, a, b, w, mode);
+        spm_pop();
+    }
+}
 
-        e += y << 1;
-        y++;
-        e += y << 1;
+// ranges of sx in row sy with ri^2 <= sx^2 + sy^2 <= ro^2
+// returns the number of ranges in r[0..1] - r[2..3]
+static i32 gfx_ring_ranges(i32 sy, i32 ri, i32 ro, i32 *r)
+{
+    i32 qo = ro * ro - sy * sy;
+    i32 qi = ri * ri - sy * sy;
+    if (qo < 0) return 0;
 
-        if (0 <= e) {
-            x--;
-            e -= x << 2;
-        }
+    i32 ko = sqrt_u32(qo);
+    if (qi <= 0) { // no hole in this row
+        r[0] = -ko, r[1] = +ko;
+        return 1;
     }
+
+    i32 ki = sqrt_u32(qi);
+    ki += (ki * ki < qi);
+    if (ko < ki) return 0;
+
+    r[0] = -ko, r[1] = -ki, r[2] = +ki, r[3] = +ko;
+    return 2;
 }
 
 // counter clockwise filled from a1 to a2
@@ -1481,76 +1924,34 @@ void gfx_fill_circle_ring_seg(gfx_ctx_s ctx, v2_i32 p, i32 ri, i32 ro, i32 a1_q1
     i32 y1 = max_i32(ctx.clip_y1, p.y - ro);
     i32 y2 = min_i32(ctx.clip_y2, p.y + ro);
     i32 x1 = max_i32(ctx.clip_x1, p.x - ro);
-    i32 x2 = min_i32(ctx.clip_x2, p.x + ro);
-    i32 r2 = ro * ro;
-    i32 r1 = ri * ri;
+    i32 x2 = min_i32(ctx.clip_x2, p.x + ro) - 1; // the right most pixel is left out
 
     // >> 2 -> avoid overflow during multiplication
     v2_i32 a = {sin_q15(a1_q17) >> 2, cos_q15(a1_q17) >> 2};
     v2_i32 b = {sin_q15(a2_q17) >> 2, cos_q15(a2_q17) >> 2};
     i32    w = v2_i32_crs(a, b);
 
-    // blit rectangle strips once the x iterator first entered and then
-    // leaves the circle segment
     for (i32 y = y1; y <= y2; y++) {
-        b32 was_inside = 0;
-        i32 x1_strip   = 0;
-
-        for (i32 x = x1; x <= x2; x++) {
-            v2_i32 s = {x - p.x, y - p.y};
-            i32    r = v2_i32_lensq(s);
-            b32    i = 0;
-
-            if (r1 <= r && r <= r2) {
-                i32 u = v2_i32_crs(a, s);
-                i32 v = v2_i32_crs(b, s);
-                i     = (0 <= w && (0 <= u && v <= 0)) || (0 >= w && (0 <= u || v <= 0));
-            }
-
-            if (i && !was_inside) {
-                x1_strip = x;
-            } else if (!i && was_inside) {
-                gfx_rec_strip(ctx, x1_strip, y, x - x1_strip, mode);
-            }
-            was_inside = i;
-        }
-        if (was_inside) {
-            gfx_rec_strip(ctx, x1_strip, y, x2 - x1_strip, mode);
-        }
+        i32 rr[4];
+        i32 rs[4];
+        i32 nr = gfx_ring_ranges(y - p.y, ri, ro, rr);
+        i32 ns = gfx_cir_seg_ranges(y - p.y, a, b, w, rs);
+        gfx_span_fill_ranges(ctx, y, x1, x2, p.x, rr, nr, rs, ns, mode);
     }
 }
 
-// counter clockwise filled from a1 to a2
 void gfx_fill_circle_ring(gfx_ctx_s ctx, v2_i32 p, i32 ri, i32 ro, i32 mode)
 {
     i32 y1 = max_i32(ctx.clip_y1, p.y - ro);
     i32 y2 = min_i32(ctx.clip_y2, p.y + ro);
     i32 x1 = max_i32(ctx.clip_x1, p.x - ro);
-    i32 x2 = min_i32(ctx.clip_x2, p.x + ro);
-    i32 r2 = ro * ro;
-    i32 r1 = ri * ri;
+    i32 x2 = min_i32(ctx.clip_x2, p.x + ro) - 1; // the right most pixel is left out
 
-    // blit rectangle strips once the x iterator first entered and then
-    // leaves the circle segment
+    i32 rall[2] = {-0xFFFF, +0xFFFF};
     for (i32 y = y1; y <= y2; y++) {
-        b32 was_inside = 0;
-        i32 x1_strip   = 0;
-
-        for (i32 x = x1; x <= x2; x++) {
-            v2_i32 s = {x - p.x, y - p.y};
-            i32    r = v2_i32_lensq(s);
-            b32    i = (r1 <= r && r <= r2);
-
-            if (i && !was_inside) {
-                x1_strip = x;
-            } else if (!i && was_inside) {
-                gfx_rec_strip(ctx, x1_strip, y, x - x1_strip, mode);
-            }
-            was_inside = i;
-        }
-        if (was_inside) {
-            gfx_rec_strip(ctx, x1_strip, y, x2 - x1_strip, mode);
-        }
+        i32 rr[4];
+        i32 nr = gfx_ring_ranges(y - p.y, ri, ro, rr);
+        gfx_span_fill_ranges(ctx, y, x1, x2, p.x, rr, nr, rall, 1, mode);
     }
 }
 
@@ -169,6 +169,16 @@ void tex_merge_to_opaque(tex_s dst, tex_s src);
 // src: top texture, transparency
 // dst: bot texture, opaque
 void          tex_merge_to_opaque_outlined_white(tex_s dst, tex_s src);
+// same as above but only for the area r (+1 px outline) of src
+void          tex_merge_to_opaque_outlined_white_rec(tex_s dst, tex_s src, rec_i32 r);
+// clears all words touched by r; row spans of whole words
+void          tex_clr_rec(tex_s dst, rec_i32 r, i32 col);
+// dirty area tracking of a few textures
+// the blitters extend the dirty rectangle when drawing into a tracked texture
+// tracking starts with the whole texture dirty (unknown contents)
+void          tex_dirty_track(tex_s t);
+void          tex_dirty_reset(tex_s t);
+rec_i32       tex_dirty_rec(tex_s t); // w = h = 0 if nothing drawn since reset
 gfx_ctx_s     gfx_ctx_from_tex(tex_s dst);
 gfx_ctx_s     gfx_ctx_display();
 gfx_ctx_s     gfx_ctx_unclip(gfx_ctx_s ctx);
@@ -190,6 +200,9 @@ gfx_pattern_s gfx_pattern_interpolatec(i32 num, i32 den, i32 (*ease)(i32 a, i32
 void          gfx_spr(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, i32 flip, i32 mode);
 void          gfx_spr_copy(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, i32 flip);
 void          gfx_spr_tile_32x32(gfx_ctx_s ctx, texrec_s src, v2_i32 pos);
+// masked sprite to an opaque target; row i is shifted in x by
+// (shear_q8 * (h - 1 - i)) >> 8 so the bottom row stays in place
+void          gfx_spr_shear_x(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, i32 shear_q8, i32 mode);
 
 // tiles spr across screen (true/false for x/y)
 void gfx_spr_tileds(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, i32 flip, i32 mode, bool32 tilex, bool32 tiley);
@@ -198,6 +211,9 @@ void gfx_spr_tileds_copy(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, bool32 tilex,
 void gfx_rec_fill(gfx_ctx_s ctx, rec_i32 rec, i32 mode);
 void gfx_rec_fill_opaque(gfx_ctx_s ctx, rec_i32 rec, i32 mode);
 void gfx_rec_strip(gfx_ctx_s ctx, i32 rx, i32 ry, i32 rw, i32 mode);
+// n columns of width cw side by side starting at x;
+// column i covers rows [top[i], y2], opaque targets only
+void gfx_fill_columns_opaque(gfx_ctx_s ctx, i32 x, i32 cw, const i16 *top, i32 n, i32 y2, i32 mode);
 void gfx_rec_rounded_fill(gfx_ctx_s ctx, rec_i32 rec, i32 r, i32 mode);
 void gfx_tri_fill(gfx_ctx_s ctx, tri_i32 t, i32 mode);
 void gfx_cir_fill(gfx_ctx_s ctx, v2_i32 p, i32 d, i32 mode);
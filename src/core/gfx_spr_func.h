@@ -55,6 +55,7 @@ void SPRBLIT_FUNCNAME(gfx_ctx_s ctx, texrec_s src, v2_i32 pos, i32 flip, i32 mod
     i32 x2 = min_i32(ctx.clip_x2, pos.x + src.w - 1);
     i32 y2 = min_i32(ctx.clip_y2, pos.y + src.h - 1);
     if (x2 < x1 || y2 < y1) return; // not visible
+    gfx_dirty_mark(ctx.dst, x1, y1, x2, y2);
 
 #if SPRBLIT_FLIPPEDX
     i32 a_x = src.x + pos.x + src.w - 1; // cached offset value
@@ -179,8 +179,7 @@ void cs_powerup_update(g_s *g, cs_s *cs, inp_s inp)
             break;
         case 130:
             // mus_play_extv(0, 0, 0, 2000, 0, 0);
-            pu->puppet_hero->render_priority = RENDER_PRIO_UI_LEVEL;
-            g->objrender_dirty               = 1;
+            obj_render_priority_set(g, pu->puppet_hero, RENDER_PRIO_UI_LEVEL);
             break;
         case CS_POWERUP_TICKS_P10:
             cs->phase++;
@@ -210,9 +209,8 @@ void cs_powerup_update(g_s *g, cs_s *cs, inp_s inp)
     case 13: {
         if (CS_POWERUP_TICKS_P13 <= cs->tick) {
             cs->phase++;
-            cs->tick                         = 0;
-            pu->puppet_hero->render_priority = RENDER_PRIO_DEFAULT_OBJ;
-            g->objrender_dirty               = 1;
+            cs->tick = 0;
+            obj_render_priority_set(g, pu->puppet_hero, RENDER_PRIO_DEFAULT_OBJ);
         }
         break;
     }
@@ -28,8 +28,9 @@ fluid_area_s *fluid_area_create(g_s *g, rec_i32 r, i32 type, b32 surface)
     a->h            = r.h;
 
     if (surface) {
-        a->s.n   = r.w / (4 << (i32)(type == FLUID_AREA_LAVA)) + 3;
-        a->s.pts = game_alloc_roomtn(g, fluid_pt_s, a->s.n);
+        a->s.n    = r.w / (4 << (i32)(type == FLUID_AREA_LAVA)) + 3;
+        a->s.y_q8 = (i32 *)game_alloc_room(g, sizeof(i32) * a->s.n, 16);
+        a->s.v_q8 = (i32 *)game_alloc_room(g, sizeof(i32) * a->s.n, 16);
 
         switch (type) {
         case FLUID_AREA_WATER:
@@ -48,7 +49,8 @@ fluid_area_s *fluid_area_create(g_s *g, rec_i32 r, i32 type, b32 surface)
             break;
         }
     } else {
-        a->s.pts   = 0;
+        a->s.y_q8  = 0;
+        a->s.v_q8  = 0;
         a->s.min_y = 0;
         a->s.max_y = 0;
     }
@@ -56,51 +58,64 @@ fluid_area_s *fluid_area_create(g_s *g, rec_i32 r, i32 type, b32 surface)
     return a;
 }
 
-void fluid_surface_step(fluid_surface_s *b)
+// returns true if the surface is calm enough to sleep
+bool32 fluid_surface_step(fluid_surface_s *b)
 {
+    i32 *y = b->y_q8;
+    i32 *v = b->v_q8;
+    i32  n = b->n;
+
     // forces and velocity integration
+    // each loop only reads what it doesn't write so it maps onto SIMD lanes
     for (i32 i = 0; i < b->steps; i++) {
-        b->pts[0].y_q8        = b->pts[1].y_q8;
-        b->pts[b->n - 1].y_q8 = b->pts[b->n - 2].y_q8;
-
-        for (i32 n = 1; n < b->n - 1; n++) {
-            fluid_pt_s *p = &b->pts[n];
-            i32         f = 0;
-            f += (p - 1)->y_q8 - p->y_q8;
-            f += (p + 1)->y_q8 - p->y_q8;
-            p->v_q8 += (f * b->c1 - p->y_q8 * b->c2) >> 16;
+        y[0]     = y[1];
+        y[n - 1] = y[n - 2];
+
+        for (i32 k = 1; k < n - 1; k++) {
+            i32 f = y[k - 1] + y[k + 1] - 2 * y[k];
+            v[k] += (f * b->c1 - y[k] * b->c2) >> 16;
         }
 
-        for (i32 n = b->n - 2; 1 <= n; n--) {
-            fluid_pt_s *p = &b->pts[n];
-            p->y_q8 += p->v_q8;
+        for (i32 k = 1; k < n - 1; k++) {
+            y[k] += v[k];
         }
     }
 
-    b->min_y = I8_MAX;
-    b->max_y = I8_MIN;
-
-    i32 vmax = 0;
     // dampening
-    for (i32 n = 0; n < b->n; n++) {
-        fluid_pt_s *p = &b->pts[n];
-        p->v_q8       = mul_q16((i32)b->d_q16, p->v_q8);
-        p->v_q8 += rngr_sym_i32(b->r);
-        i32 y    = fluid_pt_y(p->y_q8);
-        b->min_y = min_i32(b->min_y, y);
-        b->max_y = max_i32(b->max_y, y);
-        vmax     = max_i32(vmax, p->v_q8);
+    for (i32 k = 0; k < n; k++) {
+        v[k] = mul_q16((i32)b->d_q16, v[k]);
+    }
+    for (i32 k = 0; k < n; k++) {
+        v[k] += rngr_sym_i32(b->r);
+    }
+
+    i32 y_min = I32_MAX;
+    i32 y_max = I32_MIN;
+    i32 v_sum = 0;
+    for (i32 k = 0; k < n; k++) {
+        y_min = min_i32(y_min, y[k]);
+        y_max = max_i32(y_max, y[k]);
+        v_sum += abs_i32(v[k]);
     }
+    b->min_y = fluid_pt_y(y_min);
+    b->max_y = fluid_pt_y(y_max);
+
+    // calm: ambient noise only and at most one pixel of height difference
+    return (v_sum < FLUID_SURFACE_SLEEP_V_Q8 * n && b->max_y - b->min_y <= 1);
 }
 
 void fluid_area_update(fluid_area_s *b)
 {
-    if (b->s.pts) {
+    if (b->s.y_q8) {
         b->tick++;
         if (b->ticks_to_idle) {
             b->ticks_to_idle--;
         }
-        fluid_surface_step(&b->s);
+        if (!b->s.sleeping) {
+            bool32 calm = fluid_surface_step(&b->s);
+            // settle after an impact before going to sleep
+            b->s.sleeping = calm && !b->ticks_to_idle;
+        }
     }
 }
 
@@ -115,22 +130,23 @@ void fluid_area_impact(fluid_area_s *b, i32 x_mid, i32 w, i32 str, i32 type)
     if (id == 0) return;
 
     b->ticks_to_idle = 400;
+    b->s.sleeping    = 0;
 
     for (i32 i = i0; i <= i1; i++) {
-        fluid_pt_s *p = &b->s.pts[i];
+        i32 *v = &b->s.v_q8[i];
         switch (type) {
         case FLUID_AREA_IMPACT_COS: {
             i32 k = -(cos_q15(((i - i0) << 17) / id) - 32768);
-            p->v_q8 += (str * k) >> 16;
+            *v += (str * k) >> 16;
             break;
         }
         case FLUID_AREA_IMPACT_FLAT: {
-            p->v_q8 += str;
+            *v += str;
             break;
         }
         }
 
-        p->v_q8 = ssat(p->v_q8, 9);
+        *v = ssat(*v, 9);
     }
 }
 
@@ -147,27 +163,6 @@ void fluid_area_draw(gfx_ctx_s ctx, fluid_area_s *b, v2_i32 cam, i32 pass)
     case 1:
         if (b->type == FLUID_AREA_LAVA) {
             fill_col = PRIM_MODE_BLACK_WHITE;
-
-            i32 t   = b->tick << 10;
-            i32 shr = ((4 * (sin_q15(t) + 32767)) / 65536);
-            i32 shl = ((2 * (cos_q15(t * 3) + 32767)) / 65536);
-
-            if ((shr ^ shl) & 1) { // align pattern to 50/50 in screen space
-                shl++;
-            }
-            i32 pID = (b->tick / 12) % 19;
-            if (pID <= 7) {
-                if (4 <= pID) {
-                    pID = 7 - pID;
-                }
-            } else if (10 <= pID && pID <= (10 + 5)) {
-                pID -= 10;
-                if (3 <= pID) {
-                    pID = 5 - pID;
-                }
-            } else {
-                pID = 0;
-            }
         } else {
             fill_col     = PRIM_MODE_BLACK;
             ctx_fill.pat = gfx_pattern_2x2(B2(10),
@@ -183,16 +178,17 @@ void fluid_area_draw(gfx_ctx_s ctx, fluid_area_s *b, v2_i32 cam, i32 pass)
     i32 i1 = b->s.n - 2;
     i32 wi = b->type == FLUID_AREA_WATER ? 4 : 8;
 
-    // fill in the general area
-    if (b->s.pts) {
+    // fill in the general area: surface columns down to max_y as
+    // masked scanlines, the body below as one rectangle
+    if (b->s.y_q8 && i0 <= i1) {
+        spm_push();
+        i16 *top = spm_alloctn(i16, i1 - i0 + 1);
         for (i32 i = i0; i <= i1; i++) {
-            i32     y  = fluid_pt_y(b->s.pts[i].y_q8);
-            rec_i32 rp = {bx + ((i - 1) * wi),
-                          by + y,
-                          wi,
-                          b->s.max_y - y};
-            gfx_rec_fill_opaque(ctx_fill, rp, fill_col);
+            top[i - i0] = (i16)(by + fluid_pt_y(b->s.y_q8[i]));
         }
+        gfx_fill_columns_opaque(ctx_fill, bx, wi, top, i1 - i0 + 1,
+                                by + b->s.max_y - 1, fill_col);
+        spm_pop();
     }
 
     rec_i32 rfill = {bx, by + b->s.max_y, b->w, b->h - b->s.max_y};
@@ -214,7 +210,7 @@ void fluid_area_draw(gfx_ctx_s ctx, fluid_area_s *b, v2_i32 cam, i32 pass)
             // loop over 32 "frames", but only draw if it's lower than 8
             i32 bubframe = (bubanim - (i * 3)) & 31;
             if (bubframe < 8) {
-                i32    y0 = fluid_pt_y(b->s.pts[i].y_q8);
+                i32    y0 = fluid_pt_y(b->s.y_q8[i]);
                 v2_i32 p  = {bx + ((i - 1) * wi) - 16,
                              by + y0 - 14};
                 trbubg.x  = bubframe * 32;
@@ -228,8 +224,8 @@ void fluid_area_draw(gfx_ctx_s ctx, fluid_area_s *b, v2_i32 cam, i32 pass)
                                        b->type == FLUID_AREA_LAVA ? 8 : 0,
                                        wi, 8);
         for (i32 i = i0; i <= i1; i++) {
-            i32    y0 = fluid_pt_y(b->s.pts[i + 0].y_q8);
-            i32    y1 = fluid_pt_y(b->s.pts[i + 1].y_q8);
+            i32    y0 = fluid_pt_y(b->s.y_q8[i + 0]);
+            i32    y1 = fluid_pt_y(b->s.y_q8[i + 1]);
             v2_i32 p  = {bx + (i - 1) * wi,
                          by + y0 - 4};
             trsurf.x  = wi * (2 + clamp_sym_i32(y1 - y0, 2));
@@ -15,23 +15,22 @@ enum {
     FLUID_AREA_TOXIC_WATER,
 };
 
-typedef struct fluid_pt_s {
-    ALIGNAS(4)
-    i16 y_q8;
-    i16 v_q8;
-} fluid_pt_s;
+// mean abs velocity below which a calm surface stops simulating
+#define FLUID_SURFACE_SLEEP_V_Q8 16
 
 typedef struct {
     ALIGNAS(16)
-    fluid_pt_s *pts;
-    u16         n;
-    u16         d_q16;
-    i16         c1;
-    i16         c2;
-    u8          steps;
-    u8          r;
-    i8          min_y;
-    i8          max_y;
+    i32 *y_q8; // n points: height and velocity as separate arrays
+    i32 *v_q8;
+    u16  n;
+    u16  d_q16;
+    i16  c1;
+    i16  c2;
+    u8   steps;
+    u8   r;
+    i8   min_y;
+    i8   max_y;
+    b8   sleeping; // not stepped until the next impact
 } fluid_surface_s;
 
 typedef struct {
@@ -46,7 +45,7 @@ typedef struct {
     u16             h;
 } fluid_area_s;
 
-void          fluid_surface_step(fluid_surface_s *b);
+bool32        fluid_surface_step(fluid_surface_s *b);
 void          fluid_area_update(fluid_area_s *b);
 fluid_area_s *fluid_area_create(g_s *g, rec_i32 r, i32 type, b32 surface);
 void          fluid_area_destroy(g_s *g, fluid_area_s *a);
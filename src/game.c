@@ -7,9 +7,12 @@
 #include "render.h"
 
 void game_tick_gameplay(g_s *g);
+static void map_room_hash_put(g_s *g, i32 i, const void *name);
 
 void game_init(g_s *g)
 {
+    tile_masks_init();
+    map_obj_parse_init();
     g->save          = &APP.save;
     g->obj_head_free = &g->obj_raw[0];
     for (i32 n = 1; n < NUM_OBJ; n++) {
@@ -25,6 +28,7 @@ void game_init(g_s *g)
 
     assert(n_rooms <= GAME_N_ROOMS);
     g->n_map_rooms = 0;
+    mclr_static_arr(g->map_room_hash);
 
     i32 x1 = I32_MAX;
     i32 y1 = I32_MAX;
@@ -43,6 +47,7 @@ void game_init(g_s *g)
         mr.flags = mrw.flags;
         mr.t     = tex_create(mrw.w, mrw.h, 0, app_allocator(), 0);
         pltf_file_r(f, mr.t.px, tex_size_bytes(mr.t));
+        map_room_hash_put(g, g->n_map_rooms, mr.map_name);
         g->map_rooms[g->n_map_rooms++] = mr;
 
         x1 = min_i32(x1, mr.x / 25);
@@ -248,6 +253,7 @@ void game_anim(g_s *g)
     switch (g->vfx_ID) {
     default: break;
     case VFX_ID_SNOW: vfx_area_snow_update(g); break;
+    case VFX_ID_HEAT: vfx_area_heat_update(g); break;
     }
 
     // every other tick to save some CPU cycles;
@@ -377,12 +383,7 @@ void objs_animate(g_s *g)
 
 obj_s *obj_find_ID(g_s *g, i32 objID, obj_s *o)
 {
-    for (obj_s *i = o ? o->next : g->obj_head_busy; i; i = i->next) {
-        if (i->ID == objID) {
-            return i;
-        }
-    }
-    return 0;
+    return obj_find_ID_subID(g, objID, 0, o);
 }
 
 i32 game_owl_hitID_next(g_s *g)
@@ -411,13 +412,29 @@ u8 *map_loader_room_mod(g_s *g, u8 *map_name)
     return map_name;
 }
 
+static void map_room_hash_put(g_s *g, i32 i, const void *name)
+{
+    u32 k = hash_str(name);
+    while (g->map_room_hash[k & (MAP_ROOM_HASH_SIZE - 1)]) {
+        k++;
+    }
+    g->map_room_hash[k & (MAP_ROOM_HASH_SIZE - 1)] = (u16)(i + 1);
+}
+
 map_room_s *map_room_find(g_s *g, b8 transformed, const void *name)
 {
     const void *n = (const void *)(transformed ? map_loader_room_mod(g, (u8 *)name) : name);
 
-    for (i32 i = 0; i < g->n_map_rooms; i++) {
-        map_room_s *mr = &g->map_rooms[i];
-        if (str_eq_nc(mr->map_name, n)) {
+    // first exact (no case) match in room order: indices of a name
+    // are probed in insertion order; prefix queries are not matched
+    // since they hash differently
+    for (u32 k = hash_str(n);; k++) {
+        i32 i = g->map_room_hash[k & (MAP_ROOM_HASH_SIZE - 1)];
+        if (!i) break;
+
+        map_room_s *mr = &g->map_rooms[i - 1];
+        // str_eq_nc also accepts prefixes -> compare both ways
+        if (str_eq_nc(mr->map_name, n) && str_eq_nc(n, mr->map_name)) {
             return mr;
         }
     }
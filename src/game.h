@@ -15,6 +15,7 @@
 #include "fluid_area.h"
 #include "gamedef.h"
 #include "hitbox.h"
+#include "lighting.h"
 #include "map_loader.h"
 #include "minimap.h"
 #include "obj.h"
@@ -66,29 +67,31 @@ typedef struct {
     void (*cb)(g_s *g, void *arg);
 } game_on_tick_cb_s;
 
-#if 1 // prefetch the next one?
-static inline obj_s *obj_each_valid(obj_s *o)
+// steps the iterator down to the next older object
+static inline bool32 obj_each_next(obj_s **beg, obj_s ***it, obj_s **o)
 {
+    if (*it == beg) return 0;
+    (*it)--;
+    *o = **it;
+#if 1 // prefetch the next one?
     // already prefetch the next one because of iteration
     // -> likely to access the next one shortly after
-    if (o) {
-        PREFETCH(o->next);
+    if (*it != beg) {
+        PREFETCH((*it)[-1]);
     }
-    return o;
-}
-#else
-#define obj_each_valid(O) O
 #endif
+    return 1;
+}
 
 // for (obj_each(g, o)) {}
-#define obj_each(G, IT)           \
-    obj_s *IT = G->obj_head_busy; \
-    obj_each_valid(IT);           \
-    IT = IT->next
+// newest to oldest; objects created while iterating are not visited
+#define obj_each(G, IT)                                          \
+    obj_s *IT = 0, **IT##_it = &(G)->obj_busy[(G)->n_obj_busy]; \
+    obj_each_next((G)->obj_busy, &IT##_it, &IT);
 
 #define obj_each_objID(G, IT, OID)      \
     obj_s *IT = obj_find_ID(G, OID, 0); \
-    obj_each_valid(IT);                 \
+    IT;                                 \
     IT = obj_find_ID(G, OID, IT)
 
 enum {
@@ -160,6 +163,7 @@ struct g_s {
     map_room_s *map_room_cur;
     map_room_s *map_room_cur_mod;
     map_room_s  map_rooms[256];
+    u16         map_room_hash[MAP_ROOM_HASH_SIZE]; // open addressing: room index + 1 or 0
     u8          map_name[MAP_WAD_NAME_LEN];     // technical name of the room in editor (untransformed)
     u8          map_name_mod[MAP_WAD_NAME_LEN]; // technical name of the room in editor
 
@@ -196,16 +200,21 @@ struct g_s {
     u16 rtiles[NUM_TILELAYER][NUM_TILES];
     ALIGNAS(32)
     u8 fluid_streams[NUM_TILES];
+    tile_corners_s    corners;
+    tile_solid_bits_s solid_bits;
 
     ALIGNAS(16)
-    obj_s *obj_head_busy; // linked list
-    obj_s *obj_head_free; // linked list
+    u32    n_obj_busy;
+    u32    n_obj_ID_indexed;  // obj_busy[0, n) are linked into their ID bucket
+    obj_s *obj_busy[NUM_OBJ]; // live objects, oldest first
+    obj_s *obj_ID[NUM_OBJID]; // newest object of each ID
+    obj_s *obj_head_free;     // linked list
     obj_s *obj_tag[NUM_OBJ_TAGS];
     u32    obj_ndelete;
     obj_s *obj_to_delete[NUM_OBJ];
-    bool16 objrender_dirty; // resort render list?
-    u16    n_objrender;
-    obj_s *obj_render[NUM_OBJ]; // sorted render array
+    u32    obj_render_used[8];                         // bitset of non-empty render buckets
+    obj_s *obj_render[NUM_OBJ_RENDER_BUCKETS];      // head of each render priority bucket
+    obj_s *obj_render_tail[NUM_OBJ_RENDER_BUCKETS]; // tail of each render priority bucket
     obj_s  obj_raw[NUM_OBJ];
     void  *vfx_area_mem;
 
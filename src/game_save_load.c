@@ -27,6 +27,7 @@ void game_load_savefile(g_s *g)
             g->minimap.visited[(n << 1) + 0] = v;
             g->minimap.visited[(n << 1) + 1] = v;
         }
+        g->minimap.cache_valid = 0;
         g->tick             = s->tick;
         h->upgrades         = s->upgrades;
         g->minimap.n_pins   = s->n_map_pins;
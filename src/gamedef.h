@@ -75,6 +75,7 @@ enum {
 #define ENEMY_HIT_FREEZE_SHAKE_AMOUNT 2 // +/- shaking of sprite
 #define ENEMY_HIT_FLASH_TICKS         4 // ticks of white "got hit" flash
 #define GAME_N_ROOMS                  256
+#define MAP_ROOM_HASH_SIZE            (GAME_N_ROOMS * 2) // power of 2
 #define NUM_TILES                     65536
 #define MAP_WAD_NAME_LEN              12
 
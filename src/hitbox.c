@@ -36,23 +36,22 @@ void hitbox_set_flags_group(hitbox_s *hb, i32 flags)
 
 void hitbox_type_parent(hitbox_s *hb)
 {
-    NOT_IMPLEMENTED("hitbox parents");
-    hb->type  = HITBOX_TYPE_PARENT;
-    hb->u.n_c = 0;
+    hb->type      = HITBOX_TYPE_PARENT;
+    hb->u.par.n_c = 0;
 }
 
 void hitbox_parent_add_child(hitbox_s *hb_parent, hitbox_s *hb_child)
 {
-    NOT_IMPLEMENTED("hitbox parents");
     assert(hb_parent < hb_child);
+    assert(hb_parent->type == HITBOX_TYPE_PARENT);
 
-    hb_parent->u.n_c++;
+    hb_parent->u.par.n_c++;
     hb_child->parent_offs = (u8)(hb_child - hb_parent);
     hb_child->UID         = hb_parent->UID;
 #if PLTF_DEBUG
-    for (i32 n = 0; n < hb_parent->u.n_c; n++) {
+    for (i32 n = 0; n < hb_parent->u.par.n_c; n++) {
         hitbox_s *hb_child_debug = hb_parent + 1 + n;
-        assert(hb_parent = hb_child_debug - hb_child_debug->parent_offs);
+        assert(hb_parent == hb_child_debug - hb_child_debug->parent_offs);
     }
 #endif
 }
@@ -86,61 +85,310 @@ void hitbox_type_cir(hitbox_s *hb, i32 x, i32 y, i32 r)
     c->r                 = r;
 }
 
+void hitbox_type_lin(hitbox_s *hb, i32 x1, i32 y1, i32 x2, i32 y2, i32 r)
+{
+    hb->type             = HITBOX_TYPE_LIN;
+    hitbox_type_lin_s *l = &hb->u.lin;
+    l->x                 = x1;
+    l->y                 = y1;
+    l->dx                = x2 - x1;
+    l->dy                = y2 - y1;
+    l->r                 = r;
+}
+
+#define HITBOX_CELL_SHIFT 6  // 64 px cells
+#define HITBOX_GRID_MAX   32 // max cells per axis, cells grow beyond
+
+// queued hitboxes binned into a uniform grid over their bounding box
+typedef struct {
+    i32 x;
+    i32 y;
+    i32 w;
+    i32 h;
+    i32 shift;
+    i32 n_binned;   // hitboxes [0, n_binned) are binned
+    i32 n_prepared; // hitboxes [0, n_prepared) have parent bounds set
+    u16 cell_i[HITBOX_GRID_MAX * HITBOX_GRID_MAX + 1];
+    u8  hb_i[HITBOX_NUM * 4];
+} hitbox_grid_s;
+
+// conservative bounds [x1, x2] x [y1, y2] of everything the shape can hit
+static void hitbox_bounds(hitbox_s *hb, i32 *b)
+{
+    switch (hb->type) {
+    case HITBOX_TYPE_PARENT: {
+        hitbox_type_parent_s *hp = &hb->u.par;
+        b[0] = hp->x1, b[1] = hp->y1, b[2] = hp->x2, b[3] = hp->y2;
+        break;
+    }
+    case HITBOX_TYPE_REC: {
+        hitbox_type_rec_s *hr = &hb->u.rec;
+        b[0] = min_i32(hr->x1, hr->x2), b[1] = min_i32(hr->y1, hr->y2);
+        b[2] = max_i32(hr->x1, hr->x2), b[3] = max_i32(hr->y1, hr->y2);
+        break;
+    }
+    case HITBOX_TYPE_CIR: {
+        hitbox_type_cir_s *hc = &hb->u.cir;
+        b[0] = hc->x - hc->r, b[1] = hc->y - hc->r;
+        b[2] = hc->x + hc->r, b[3] = hc->y + hc->r;
+        break;
+    }
+    case HITBOX_TYPE_LIN: {
+        hitbox_type_lin_s *hl = &hb->u.lin;
+        b[0] = min_i32(hl->x, hl->x + hl->dx) - hl->r;
+        b[1] = min_i32(hl->y, hl->y + hl->dy) - hl->r;
+        b[2] = max_i32(hl->x, hl->x + hl->dx) + hl->r;
+        b[3] = max_i32(hl->y, hl->y + hl->dy) + hl->r;
+        break;
+    }
+    default:
+        b[0] = 0, b[1] = 0, b[2] = -1, b[3] = -1;
+        break;
+    }
+}
+
+// sets the bounds of a parent to the union of its children's bounds
+static void hitbox_prepare(hitbox_s *hb)
+{
+    if (hb->type != HITBOX_TYPE_PARENT) return;
+
+    hitbox_type_parent_s *hp = &hb->u.par;
+    hp->x1 = I32_MAX, hp->y1 = I32_MAX;
+    hp->x2 = I32_MIN, hp->y2 = I32_MIN;
+    for (i32 n = 0; n < hp->n_c; n++) {
+        hitbox_s *hc = hb + 1 + n;
+        assert(hc->type != HITBOX_TYPE_PARENT);
+        i32 b[4];
+        hitbox_bounds(hc, b);
+        if (b[2] < b[0]) continue;
+        hp->x1 = min_i32(hp->x1, b[0]);
+        hp->y1 = min_i32(hp->y1, b[1]);
+        hp->x2 = max_i32(hp->x2, b[2]);
+        hp->y2 = max_i32(hp->y2, b[3]);
+    }
+    if (hp->x2 < hp->x1) { // no children to hit anything
+        hp->x1 = 0, hp->y1 = 0, hp->x2 = -1, hp->y2 = -1;
+    }
+}
+
+// bounds [x1, x2] x [y1, y2] of an object's aabb
+static void hitbox_obj_bounds(rec_i32 r, i32 *b)
+{
+    b[0] = min_i32(r.x, r.x + r.w);
+    b[1] = min_i32(r.y, r.y + r.h);
+    b[2] = max_i32(r.x, r.x + r.w);
+    b[3] = max_i32(r.y, r.y + r.h);
+}
+
+static bool32 hitbox_overlaps(hitbox_s *hb, rec_i32 r, i32 *rb)
+{
+    switch (hb->type) {
+    case HITBOX_TYPE_PARENT: {
+        hitbox_type_parent_s *hp = &hb->u.par;
+        if (rb[2] < hp->x1 || hp->x2 < rb[0] || rb[3] < hp->y1 || hp->y2 < rb[1])
+            return 0; // prune all children
+
+        for (i32 n = 0; n < hp->n_c; n++) {
+            if (hitbox_overlaps(hb + 1 + n, r, rb)) return 1;
+        }
+        return 0;
+    }
+    case HITBOX_TYPE_REC: {
+        hitbox_type_rec_s *hr = &hb->u.rec;
+        rec_i32            rr = {hr->x1, hr->y1, hr->x2 - hr->x1, hr->y2 - hr->y1};
+        return overlap_rec(r, rr);
+    }
+    case HITBOX_TYPE_CIR: {
+        hitbox_type_cir_s *hc = &hb->u.cir;
+        return overlap_rec_cir(r, hc->x, hc->y, hc->r);
+    }
+    case HITBOX_TYPE_LIN: {
+        hitbox_type_lin_s *hl = &hb->u.lin;
+        v2_i32             a  = {hl->x, hl->y};
+        v2_i32             b  = {hl->x + hl->dx, hl->y + hl->dy};
+        return overlap_rec_capsule(r, a, b, hl->r);
+    }
+    }
+    return 0;
+}
+
+// returns true if the hitbox hits the object, accumulates the result
+static bool32 hitbox_try_hit(obj_s *o, rec_i32 o_aabb, i32 *o_b, hitbox_s *hb, hitbox_res_s *res)
+{
+    if (hb->parent_offs) return 0; // tested through its parent
+    if (!(o->hitbox_flags_group & hb->flags_group)) return 0;
+    if (obj_from_handle(hb->user) == o) return 0; // dont hit yourself i.e. enemy should also damage other enemies but of course not itself
+    if (!hitbox_overlaps(hb, o_aabb, o_b)) return 0;
+
+    // already hit by this UID earlier?
+    for (i32 i = 0; i < OBJ_NUM_HITBOXID; i++) {
+        if (hb->UID == o->hitboxUID_registered[i]) {
+            return 0; // does not hit
+        }
+    }
+
+    res->damage += hb->damage;
+    res->dx_q4 += hb->dx_q4;
+    res->dy_q4 += hb->dy_q4;
+
+    o->hitboxUID_registered[o->n_hitboxUID_registered++] = hb->UID; // remember this UID
+    o->n_hitboxUID_registered &= (OBJ_NUM_HITBOXID - 1);
+    if (o->hitbox_flags_group & HITBOX_FLAG_GROUP_TRIGGERS_CALLBACK) {
+        hb->flags |= HITBOX_FLAG_HIT;
+    }
+    return 1;
+}
+
+static bool32 hitbox_is_binned(hitbox_s *hb)
+{
+    return (hb->flags_group && !hb->parent_offs &&
+            (hb->type == HITBOX_TYPE_PARENT || hb->type == HITBOX_TYPE_REC ||
+             hb->type == HITBOX_TYPE_CIR || hb->type == HITBOX_TYPE_LIN));
+}
+
+// cell range [*c1, *c2] covering [p1, p2]
+static void hitbox_grid_cells(i32 p1, i32 p2, i32 o, i32 n, i32 shift, i32 *c1, i32 *c2)
+{
+    *c1 = clamp_i32((p1 - o) >> shift, 0, n - 1);
+    *c2 = clamp_i32((p2 - o) >> shift, 0, n - 1);
+}
+
+static void hitbox_grid_build(g_s *g, hitbox_grid_s *gr)
+{
+    i32 x1 = I32_MAX, y1 = I32_MAX;
+    i32 x2 = I32_MIN, y2 = I32_MIN;
+    for (i32 n = 0; n < g->n_hitboxes; n++) {
+        hitbox_s *hb = &g->hitboxes[n];
+        hitbox_prepare(hb);
+        if (!hitbox_is_binned(hb)) continue;
+
+        i32 b[4];
+        hitbox_bounds(hb, b);
+        x1 = min_i32(x1, b[0]);
+        y1 = min_i32(y1, b[1]);
+        x2 = max_i32(x2, b[2]);
+        y2 = max_i32(y2, b[3]);
+    }
+
+    gr->n_binned   = g->n_hitboxes;
+    gr->n_prepared = g->n_hitboxes;
+    gr->shift      = HITBOX_CELL_SHIFT;
+    if (x2 < x1) { // nothing to bin
+        gr->w = 0;
+        gr->h = 0;
+        return;
+    }
+    while (HITBOX_GRID_MAX <= ((x2 - x1) >> gr->shift) ||
+           HITBOX_GRID_MAX <= ((y2 - y1) >> gr->shift)) {
+        gr->shift++;
+    }
+    gr->x = x1;
+    gr->y = y1;
+    gr->w = ((x2 - x1) >> gr->shift) + 1;
+    gr->h = ((y2 - y1) >> gr->shift) + 1;
+
+    // count per cell, then prefix sum into start indices
+    i32 n_cells = gr->w * gr->h;
+    mclr(gr->cell_i, sizeof(u16) * (n_cells + 1));
+    for (i32 pass = 0; pass < 2; pass++) {
+        for (i32 n = 0; n < gr->n_binned; n++) {
+            hitbox_s *hb = &g->hitboxes[n];
+            if (!hitbox_is_binned(hb)) continue;
+
+            i32 b[4];
+            i32 cx1, cy1, cx2, cy2;
+            hitbox_bounds(hb, b);
+            if (b[2] < b[0]) continue; // can't hit anything
+            hitbox_grid_cells(b[0], b[2], gr->x, gr->w, gr->shift, &cx1, &cx2);
+            hitbox_grid_cells(b[1], b[3], gr->y, gr->h, gr->shift, &cy1, &cy2);
+            for (i32 cy = cy1; cy <= cy2; cy++) {
+                for (i32 cx = cx1; cx <= cx2; cx++) {
+                    i32 c = cx + cy * gr->w;
+                    if (pass == 0) {
+                        gr->cell_i[c + 1]++;
+                    } else {
+                        gr->hb_i[gr->cell_i[c]++] = n;
+                    }
+                }
+            }
+        }
+
+        if (pass == 0) {
+            for (i32 c = 0; c < n_cells; c++) {
+                gr->cell_i[c + 1] += gr->cell_i[c];
+            }
+            if (ARRLEN(gr->hb_i) < gr->cell_i[n_cells]) { // too many cells covered
+                gr->w = 0;
+                gr->h = 0;
+                return;
+            }
+        }
+    }
+    // cell_i[c] was advanced to the start of cell c + 1 while filling
+    for (i32 c = n_cells; 0 < c; c--) {
+        gr->cell_i[c] = gr->cell_i[c - 1];
+    }
+    gr->cell_i[0] = 0;
+}
+
 void hitboxes_flush(g_s *g)
 {
+    spm_push();
+    hitbox_grid_s *gr = spm_alloct(hitbox_grid_s);
+    hitbox_grid_build(g, gr);
+
     for (obj_each(g, o)) {
         if (!o->hitbox_flags_group) continue;
 
         rec_i32      o_aabb  = obj_aabb(o);
         hitbox_res_s res     = {0};
         bool32       was_hit = 0;
+        i32          o_b[4];
+        hitbox_obj_bounds(o_aabb, o_b);
 
-        for (i32 n = 0; n < g->n_hitboxes; n++) {
-            hitbox_s *hb = &g->hitboxes[n];
-            if (!(o->hitbox_flags_group & hb->flags_group)) continue;
-            if (obj_from_handle(hb->user) == o) continue; // dont hit yourself i.e. enemy should also damage other enemies but of course not itself
-
-            switch (hb->type) {
-            default:
-            case HITBOX_TYPE_NULL: goto HITBOX_NEXT; // does not hit
-            case HITBOX_TYPE_REC: {
-                hitbox_type_rec_s *hr = &hb->u.rec;
-                rec_i32            r  = {hr->x1, hr->y1, hr->x2 - hr->x1, hr->y2 - hr->y1};
-
-                if (!overlap_rec(o_aabb, r)) goto HITBOX_NEXT; // does not hit
-                break;
-            }
-            case HITBOX_TYPE_CIR: {
-                hitbox_type_cir_s *hc = &hb->u.cir;
-                if (1) goto HITBOX_NEXT; // does not hit
-                break;
+        if (gr->w == 0) {
+            // no grid: test all hitboxes
+            for (i32 n = 0; n < gr->n_binned; n++) {
+                was_hit |= hitbox_try_hit(o, o_aabb, o_b, &g->hitboxes[n], &res);
             }
+        } else {
+            // mark the hitboxes in all touched cells, test in queue order
+            u32 hb_set[HITBOX_NUM / 32] = {0};
+            i32 cx1, cy1, cx2, cy2;
+            hitbox_grid_cells(o_b[0], o_b[2], gr->x, gr->w, gr->shift, &cx1, &cx2);
+            hitbox_grid_cells(o_b[1], o_b[3], gr->y, gr->h, gr->shift, &cy1, &cy2);
+            for (i32 cy = cy1; cy <= cy2; cy++) {
+                for (i32 cx = cx1; cx <= cx2; cx++) {
+                    i32 c = cx + cy * gr->w;
+                    for (i32 k = gr->cell_i[c]; k < gr->cell_i[c + 1]; k++) {
+                        i32 n = gr->hb_i[k];
+                        hb_set[n >> 5] |= (u32)1 << (n & 31);
+                    }
+                }
             }
 
-            // already hit by this UID earlier?
-            for (i32 i = 0; i < OBJ_NUM_HITBOXID; i++) {
-                if (hb->UID == o->hitboxUID_registered[i]) {
-                    goto HITBOX_NEXT; // does not hit
+            for (i32 i = 0; i < ARRLEN(hb_set); i++) {
+                for (u32 m = hb_set[i], n = i << 5; m; m >>= 1, n++) {
+                    if (m & 1) {
+                        was_hit |= hitbox_try_hit(o, o_aabb, o_b, &g->hitboxes[n], &res);
+                    }
                 }
             }
+        }
 
-            was_hit = 1;
-            res.damage += hb->damage;
-            res.dx_q4 += hb->dx_q4;
-            res.dy_q4 += hb->dy_q4;
-
-            o->hitboxUID_registered[o->n_hitboxUID_registered++] = hb->UID; // remember this UID
-            o->n_hitboxUID_registered &= (OBJ_NUM_HITBOXID - 1);
-            if (o->hitbox_flags_group & HITBOX_FLAG_GROUP_TRIGGERS_CALLBACK) {
-                hb->flags |= HITBOX_FLAG_HIT;
-            }
-        HITBOX_NEXT:;
+        // hitboxes queued by hit callbacks during this flush
+        for (; gr->n_prepared < g->n_hitboxes; gr->n_prepared++) {
+            hitbox_prepare(&g->hitboxes[gr->n_prepared]);
+        }
+        for (i32 n = gr->n_binned; n < g->n_hitboxes; n++) {
+            was_hit |= hitbox_try_hit(o, o_aabb, o_b, &g->hitboxes[n], &res);
         }
 
         if (was_hit && o->on_hitbox) {
             o->on_hitbox(g, o, res);
         }
     }
+    spm_pop();
 
     // callbacks and clearing of hitbox queue
     for (i32 n = 0; n < g->n_hitboxes; n++) {
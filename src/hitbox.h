@@ -70,7 +70,7 @@ typedef struct {
     i32 r;
 } hitbox_type_cir_s;
 
-typedef struct {
+typedef struct { // capsule: segment with radius
     i32 x;
     i32 y;
     i16 dx;
@@ -78,6 +78,14 @@ typedef struct {
     i16 r;
 } hitbox_type_lin_s;
 
+typedef struct {
+    i32 n_c; // number of children following the parent in the queue
+    i32 x1;  // bounds of all children, set during flush
+    i32 y1;
+    i32 x2;
+    i32 y2;
+} hitbox_type_parent_s;
+
 struct hitbox_s {
     ALIGNAS(32)
     u32          UID;    // unique ID, incremented per hitbox
@@ -94,10 +102,10 @@ struct hitbox_s {
     i16 dx_q4;
     i16 dy_q4;
     union {
-        i32               n_c; // number of children if parent
-        hitbox_type_rec_s rec;
-        hitbox_type_cir_s cir;
-        hitbox_type_lin_s lin;
+        hitbox_type_parent_s par;
+        hitbox_type_rec_s    rec;
+        hitbox_type_cir_s    cir;
+        hitbox_type_lin_s    lin;
     } u;
 };
 
@@ -105,11 +113,12 @@ u32       hitbox_UID_gen(g_s *g);
 hitbox_s *hitbox_gen(g_s *g, u32 UID, i32 ID, hitbox_cb_f cb, void *cb_arg); // add a hitbox with UID; if 0 then the hitbox will receive a new UID
 void      hitbox_set_user(hitbox_s *hb, obj_s *o);                           // sets a user to not be able to hit itself even if in the same group
 void      hitbox_set_flags_group(hitbox_s *hb, i32 flags);
-void      hitbox_type_parent(hitbox_s *hb);
-void      hitbox_parent_add_child(hitbox_s *hb_parent, hitbox_s *hb_child);
+void      hitbox_type_parent(hitbox_s *hb);                                  // hits if any child hits; damage and groups of the parent apply
+void      hitbox_parent_add_child(hitbox_s *hb_parent, hitbox_s *hb_child); // children have to be queued right after their parent
 void      hitbox_type_recr(hitbox_s *hb, rec_i32 r);
 void      hitbox_type_recxy(hitbox_s *hb, i32 x1, i32 y1, i32 x2, i32 y2);
 void      hitbox_type_rec(hitbox_s *hb, i32 x, i32 y, i32 w, i32 h);
 void      hitbox_type_cir(hitbox_s *hb, i32 x, i32 y, i32 r);
+void      hitbox_type_lin(hitbox_s *hb, i32 x1, i32 y1, i32 x2, i32 y2, i32 r);
 void      hitboxes_flush(g_s *g);
 #endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+// =============================================================================
+// Copyright 2024, Lukas Wolski (the.strupf@proton.me). All rights reserved.
+// =============================================================================
+
+#include "lighting.h"
+#include "game.h"
+
+// cached radial light: half width of every ring per row distance to the center
+// dithering is done in screen space when compositing so the pattern doesn't
+// move along with the light
+typedef struct {
+    u16 r;
+    u32 used; // eviction age
+    u8  dx[LIGHT_NUM_RINGS][LIGHT_RADIUS_MAX + 1];
+} light_stamp_s;
+
+typedef struct {
+    v2_i32 p;
+    i32    r;
+    i32    n_rings;
+    i32    y1;
+    i32    y2;
+} light_vis_s;
+
+static light_stamp_s g_light_stamps[LIGHT_NUM_STAMPS];
+static u32           g_light_stamps_tick;
+
+static const i32 g_light_ring_q8[LIGHT_NUM_RINGS] = {256, 220, 190, 150};
+
+static light_stamp_s *light_stamp_get(i32 r)
+{
+    assert(0 < r && r <= LIGHT_RADIUS_MAX);
+    light_stamp_s *s = &g_light_stamps[0];
+    g_light_stamps_tick++;
+
+    for (i32 n = 0; n < LIGHT_NUM_STAMPS; n++) {
+        light_stamp_s *k = &g_light_stamps[n];
+        if (k->r == r) {
+            k->used = g_light_stamps_tick;
+            return k;
+        }
+        if (k->used < s->used) {
+            s = k;
+        }
+    }
+
+    // evict the oldest stamp and rasterize
+    s->r    = r;
+    s->used = g_light_stamps_tick;
+    for (i32 i = 0; i < LIGHT_NUM_RINGS; i++) {
+        i32 r2 = pow2_i32((g_light_ring_q8[i] * r) >> 8);
+        for (i32 dy = 0; dy <= r; dy++) {
+            s->dx[i][dy] = (u8)sqrt_u32(max_i32(r2 - dy * dy, 0));
+        }
+    }
+    return s;
+}
+
+// ORs the pattern into the pixels [x1, x2] of an opaque screen row
+static void light_span(u32 *row, i32 x1, i32 x2, u32 pt)
+{
+    x1 = max_i32(x1, 0);
+    x2 = min_i32(x2, PLTF_DISPLAY_W - 1);
+    if (x2 < x1) return;
+
+    i32 w1 = x1 >> 5;
+    i32 w2 = x2 >> 5;
+    u32 ml = bswap32(0xFFFFFFFFU >> (x1 & 31));
+    u32 mr = bswap32(0xFFFFFFFFU << (31 - (x2 & 31)));
+
+    if (w1 == w2) {
+        row[w1] |= ml & mr & pt;
+        return;
+    }
+    row[w1] |= ml & pt;
+    for (i32 w = w1 + 1; w < w2; w++) {
+        row[w] |= pt;
+    }
+    row[w2] |= mr & pt;
+}
+
+void lighting_draw(g_s *g, tex_s dst, v2_i32 cam)
+{
+    assert(dst.fmt == TEX_FMT_OPAQUE && dst.wword == LIGHT_TILES_X);
+
+    ALIGNAS(32) light_vis_s lights[LIGHT_MAX_VISIBLE];
+    u32                     tiles[LIGHT_TILES_Y] = {0}; // touched tiles per tile row
+    i32                     n_lights             = 0;
+
+    // cull lights against the screen and mark touched tiles
+    for (obj_each(g, it)) {
+        if (!(it->flags & OBJ_FLAG_LIGHT) || it->light_radius == 0) continue;
+
+        i32    r  = it->light_radius;
+        v2_i32 p  = v2_i32_add(obj_pos_center(it), cam);
+        i32    x1 = max_i32(p.x - r - 1, 0); // +/- 1 px row jitter
+        i32    x2 = min_i32(p.x + r, PLTF_DISPLAY_W - 1);
+        i32    y1 = max_i32(p.y - r, 0);
+        i32    y2 = min_i32(p.y + r, PLTF_DISPLAY_H - 1);
+        if (x2 < x1 || y2 < y1) continue;
+        if (n_lights == LIGHT_MAX_VISIBLE) { // remaining lights are not drawn
+#if PLTF_DEV_ENV
+            static bool32 logged;
+            if (!logged) {
+                logged = 1;
+                pltf_log("Lights: more than %i visible\n", LIGHT_MAX_VISIBLE);
+            }
+#endif
+            break;
+        }
+
+        light_vis_s *l = &lights[n_lights++];
+        l->p           = p;
+        l->r           = r;
+        l->n_rings     = min_i32(it->light_strength + 1, LIGHT_NUM_RINGS);
+        l->y1          = y1;
+        l->y2          = y2;
+
+        u32 m = (0xFFFFFFFFU >> (31 - (x2 >> 5))) & (0xFFFFFFFFU << (x1 >> 5));
+        for (i32 ty = y1 / LIGHT_TILE_H; ty <= y2 / LIGHT_TILE_H; ty++) {
+            tiles[ty] |= m;
+        }
+    }
+
+    spm_push();
+    tex_s tlight = tex_create(PLTF_DISPLAY_W, PLTF_DISPLAY_H, 0, spm_allocator(), 0);
+
+    // only clear touched tiles; the others are never read
+    for (i32 ty = 0; ty < LIGHT_TILES_Y; ty++) {
+        if (!tiles[ty]) continue;
+
+        u32 *pl = &tlight.px[ty * LIGHT_TILE_H * tlight.wword];
+        for (i32 y = 0; y < LIGHT_TILE_H; y++, pl += tlight.wword) {
+            for (i32 tx = 0; tx < LIGHT_TILES_X; tx++) {
+                if (tiles[ty] & ((u32)1 << tx)) {
+                    pl[tx] = 0;
+                }
+            }
+        }
+    }
+
+    gfx_pattern_s pts[LIGHT_NUM_RINGS] = {
+        gfx_pattern_2x2(B2(00), B2(10)),
+        gfx_pattern_2x2(B2(01), B2(10)),
+        gfx_pattern_2x2(B2(11), B2(10)),
+        gfx_pattern_2x2(B2(11), B2(11))};
+
+    for (i32 n = 0; n < n_lights; n++) {
+        light_vis_s   *l    = &lights[n];
+        light_stamp_s *s    = light_stamp_get(l->r);
+        u32            seed = pltf_cur_tick() >> 1;
+
+        for (i32 y = l->y1; y <= l->y2; y++) {
+            i32  px  = l->p.x + rngsr_i32(&seed, -1, +1);
+            i32  dy  = abs_i32(l->p.y - y);
+            u32 *row = &tlight.px[y * tlight.wword];
+
+            for (i32 i = 0; i < l->n_rings; i++) {
+                i32 dx = s->dx[i][dy];
+                if (dx) {
+                    light_span(row, px - dx, px + dx - 1, pts[i].p[y & 7]);
+                }
+            }
+        }
+    }
+
+    // multiply lit tiles, untouched tiles are black
+    u32 *pd = dst.px;
+    u32 *pl = tlight.px;
+    for (i32 ty = 0; ty < LIGHT_TILES_Y; ty++) {
+        u32 t = tiles[ty];
+        if (!t) {
+            mclr(pd, LIGHT_TILE_H * PLTF_DISPLAY_WBYTES);
+            pd += LIGHT_TILE_H * dst.wword;
+            pl += LIGHT_TILE_H * tlight.wword;
+            continue;
+        }
+
+        for (i32 y = 0; y < LIGHT_TILE_H; y++) {
+            for (i32 tx = 0; tx < LIGHT_TILES_X; tx++) {
+                pd[tx] = (t & ((u32)1 << tx)) ? pd[tx] & pl[tx] : 0;
+            }
+            pd += dst.wword;
+            pl += tlight.wword;
+        }
+    }
+    spm_pop();
+}
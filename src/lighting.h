@@ -0,0 +1,22 @@
+// =============================================================================
+// Copyright 2024, Lukas Wolski (the.strupf@proton.me). All rights reserved.
+// =============================================================================
+
+#ifndef LIGHTING_H
+#define LIGHTING_H
+
+#include "gamedef.h"
+
+#define LIGHT_NUM_RINGS   4
+#define LIGHT_NUM_STAMPS  8
+#define LIGHT_RADIUS_MAX  255
+#define LIGHT_MAX_VISIBLE 64
+#define LIGHT_TILE_H      16 // screen tiles are one word (32 px) wide
+#define LIGHT_TILES_X     PLTF_DISPLAY_WWORDS
+#define LIGHT_TILES_Y     (PLTF_DISPLAY_H / LIGHT_TILE_H)
+
+// multiplies the display with the lights of all objects flagged
+// OBJ_FLAG_LIGHT; screen tiles without any light become black
+void lighting_draw(g_s *g, tex_s dst, v2_i32 cam);
+
+#endif
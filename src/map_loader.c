@@ -66,6 +66,23 @@ typedef struct {
     u8 c[64];
 } map_string_s;
 
+// sorted lookup of all object properties of the current room
+// ordered by object, then by property name hash
+typedef struct {
+    u32 mo;   // word offset of the object from g->map_objs
+    u16 hash; // property name hash
+    u16 offs; // word offset of the property from the object
+} map_prop_key_s;
+
+typedef struct {
+    byte           *objs;
+    byte           *objs_end;
+    map_prop_key_s *keys;
+    i32             n_keys;
+} map_prop_index_s;
+
+static map_prop_index_s g_map_prop_index;
+
 enum {
     TILE_FLIP_DIA = 1 << 0,
     TILE_FLIP_Y   = 1 << 1,
@@ -79,15 +96,15 @@ static inline void map_proptile_decode(u16 t, i32 *tx, i32 *ty, i32 *f)
     *ty = (t >> 7) & B8(01111111);
 }
 
-static map_prop_s      *map_prop_get(map_properties_s p, const char *name);
+static void             map_prop_index_build(g_s *g);
+static map_prop_s      *map_prop_get(map_properties_s p, u32 h);
 static map_properties_s map_obj_properties(map_obj_s *mo);
 
-#define map_prop_strs(P, NAME, B) map_prop_str(P, NAME, B, sizeof(B))
-static bool32 map_prop_str(map_properties_s p, const char *name, void *b, u32 bs);
-static i32    map_prop_i32(map_properties_s p, const char *name);
-static f32    map_prop_f32(map_properties_s p, const char *name);
-static bool32 map_prop_bool(map_properties_s p, const char *name);
-static v2_i16 map_prop_pt(map_properties_s p, const char *name);
+#define map_prop_i32(P, NAME) map_prop_i32_h(P, MAP_PROP_HASH(NAME))
+static bool32 map_prop_str_h(map_properties_s p, u32 h, void *b, u32 bs);
+static i32    map_prop_i32_h(map_properties_s p, u32 h);
+static f32    map_prop_f32_h(map_properties_s p, u32 h);
+static v2_i16 map_prop_pt_h(map_properties_s p, u32 h);
 
 void loader_load_terrain(g_s *g, void *f, wad_el_s *wad_el, i32 w, i32 h, u32 *seed_visuals);
 void loader_load_bgauto(g_s *g, void *f, wad_el_s *wad_el, i32 w, i32 h);
@@ -162,7 +179,10 @@ void game_load_map(g_s *g, u8 *map_name)
     g->map_room_cur     = map_room_find(g, 0, map_name);
     g->map_room_cur_mod = map_room_find(g, 0, map_name_mod);
     marena_reset(&g->memarena, 0);
+    mclr_field(g_map_prop_index);
     assert(g->map_room_cur);
+    tile_map_corners_init(g);
+    tile_map_solid_bits_init(g);
 
     // PROPERTIES ==============================================================
     i32 area_ID       = map_prop_i32(mapp, "AREA_ID");
@@ -175,6 +195,9 @@ void game_load_map(g_s *g, u8 *map_name)
     case VFX_ID_SNOW:
         vfx_area_snow_setup(g);
         break;
+    case VFX_ID_HEAT:
+        vfx_area_heat_setup(g);
+        break;
     }
 
     background_set(g, background_ID);
@@ -228,12 +251,14 @@ void game_load_map(g_s *g, u8 *map_name)
     g->map_objs      = game_alloc_room(g, e_objs->size, 4);
     g->map_objs_end  = (byte *)g->map_objs + e_objs->size;
     pltf_file_r(f, g->map_objs, e_objs->size);
+    map_prop_index_build(g);
 
     for (map_obj_each(g, o)) {
         if (!map_obj_bool(o, "Battleroom")) {
             map_obj_parse(g, o);
         }
     }
+    tile_map_solid_bits_update(g, 0, 0, g->tiles_x - 1, g->tiles_y - 1);
 
     if (0) {
     } else if (hd->hash == hash_str("L_BOSS_1A")) {
@@ -330,13 +355,80 @@ void loader_load_bg(g_s *g, void *f, wad_el_s *wad_el, i32 w, i32 h)
     spm_pop();
 }
 
-static map_prop_s *map_prop_get(map_properties_s p, const char *name)
+static map_prop_s *map_prop_at(void *p, i32 offs)
+{
+    return (map_prop_s *)((u32 *)p + offs);
+}
+
+// indexes the properties of every object once per room load
+static void map_prop_index_build(g_s *g)
+{
+    map_prop_index_s *ix = &g_map_prop_index;
+    mclr(ix, sizeof(map_prop_index_s));
+
+    i32 n_keys = 0;
+    for (map_obj_each(g, o)) {
+        n_keys += o->n_prop;
+    }
+
+    ix->keys     = game_alloc_roomtn(g, map_prop_key_s, max_i32(n_keys, 1));
+    ix->objs     = (byte *)g->map_objs;
+    ix->objs_end = (byte *)g->map_objs_end;
+
+    for (map_obj_each(g, o)) {
+        map_prop_key_s *k    = &ix->keys[ix->n_keys];
+        u32             mo   = (u32)((byte *)o - ix->objs) >> 2;
+        i32             offs = sizeof(map_obj_s) >> 2;
+
+        for (i32 n = 0; n < o->n_prop; n++) {
+            map_prop_s    *prop = map_prop_at(o, offs);
+            map_prop_key_s key  = {mo, prop->hash, (u16)offs};
+
+            // stable insertion sort: equal hashes keep file order so lookups
+            // resolve to the same property as a linear scan would
+            i32 i = n;
+            for (; 0 < i && key.hash < k[i - 1].hash; i--) {
+                k[i] = k[i - 1];
+            }
+            k[i] = key;
+            offs += prop->size_words;
+        }
+        ix->n_keys += o->n_prop;
+    }
+}
+
+static map_prop_s *map_prop_get(map_properties_s p, u32 h)
 {
     if (!p.p) return 0;
 
-    u32   h   = hash_str16(name);
-    byte *ptr = (byte *)p.p;
+    map_prop_index_s *ix = &g_map_prop_index;
+    byte             *mo = (byte *)p.p - sizeof(map_obj_s);
+
+    if (ix->objs <= mo && mo < ix->objs_end) {
+        // binary search for the first key >= (object, hash)
+        u32 k_mo = (u32)(mo - ix->objs) >> 2;
+        i32 lo   = 0;
+        i32 hi   = ix->n_keys;
+        while (lo < hi) {
+            i32             m = (lo + hi) >> 1;
+            map_prop_key_s *k = &ix->keys[m];
+            if (k->mo < k_mo || (k->mo == k_mo && k->hash < h)) {
+                lo = m + 1;
+            } else {
+                hi = m;
+            }
+        }
+        if (lo < ix->n_keys) {
+            map_prop_key_s *k = &ix->keys[lo];
+            if (k->mo == k_mo && k->hash == h) {
+                return map_prop_at(mo, k->offs);
+            }
+        }
+        return 0;
+    }
 
+    // not part of the room's objects (e.g. map header): linear scan
+    byte *ptr = (byte *)p.p;
     for (i32 n = 0; n < p.n; n++) {
         map_prop_s *prop = (map_prop_s *)ptr;
 
@@ -348,10 +440,10 @@ static map_prop_s *map_prop_get(map_properties_s p, const char *name)
     return 0;
 }
 
-static bool32 map_prop_str(map_properties_s p, const char *name, void *b, u32 bs)
+static bool32 map_prop_str_h(map_properties_s p, u32 h, void *b, u32 bs)
 {
     if (!b || bs == 0) return 0;
-    map_prop_s *prop = map_prop_get(p, name);
+    map_prop_s *prop = map_prop_get(p, h);
     if (!prop || prop->type != MAP_PROP_STRING) return 0;
     char *s       = (char *)(prop + 1);
     char *d       = (char *)b;
@@ -367,28 +459,23 @@ static bool32 map_prop_str(map_properties_s p, const char *name, void *b, u32 bs
     return 1;
 }
 
-static i32 map_prop_i32(map_properties_s p, const char *name)
+static i32 map_prop_i32_h(map_properties_s p, u32 h)
 {
-    map_prop_s *prop = map_prop_get(p, name);
+    map_prop_s *prop = map_prop_get(p, h);
     if (!prop || prop->type != MAP_PROP_INT) return 0;
     return prop->u.i;
 }
 
-static f32 map_prop_f32(map_properties_s p, const char *name)
+static f32 map_prop_f32_h(map_properties_s p, u32 h)
 {
-    map_prop_s *prop = map_prop_get(p, name);
+    map_prop_s *prop = map_prop_get(p, h);
     if (!prop || prop->type != MAP_PROP_FLOAT) return 0.f;
     return prop->u.f;
 }
 
-static bool32 map_prop_bool(map_properties_s p, const char *name)
-{
-    return map_prop_i32(p, name);
-}
-
-static v2_i16 map_prop_pt(map_properties_s p, const char *name)
+static v2_i16 map_prop_pt_h(map_properties_s p, u32 h)
 {
-    map_prop_s *prop = map_prop_get(p, name);
+    map_prop_s *prop = map_prop_get(p, h);
     if (!prop || prop->type != MAP_PROP_POINT) return CINIT(v2_i16){0};
     v2_i16 pt = {(i16)(prop->u.p & 0xFFFFU), (i16)(prop->u.p >> 16)};
     return pt;
@@ -400,41 +487,41 @@ static map_properties_s map_obj_properties(map_obj_s *mo)
     return p;
 }
 
-bool32 map_obj_has_nonnull_prop(map_obj_s *mo, const char *name)
+bool32 map_obj_has_nonnull_prop_h(map_obj_s *mo, u32 h)
 {
-    map_prop_s *prop = map_prop_get(map_obj_properties(mo), name);
+    map_prop_s *prop = map_prop_get(map_obj_properties(mo), h);
     if (!prop) return 0;
     return (prop->type != MAP_PROP_NULL);
 }
 
-bool32 map_obj_str(map_obj_s *mo, const char *name, void *b, u32 bs)
+bool32 map_obj_str_h(map_obj_s *mo, u32 h, void *b, u32 bs)
 {
-    return map_prop_str(map_obj_properties(mo), name, b, bs);
+    return map_prop_str_h(map_obj_properties(mo), h, b, bs);
 }
 
-i32 map_obj_i32(map_obj_s *mo, const char *name)
+i32 map_obj_i32_h(map_obj_s *mo, u32 h)
 {
-    return map_prop_i32(map_obj_properties(mo), name);
+    return map_prop_i32_h(map_obj_properties(mo), h);
 }
 
-f32 map_obj_f32(map_obj_s *mo, const char *name)
+f32 map_obj_f32_h(map_obj_s *mo, u32 h)
 {
-    return map_prop_f32(map_obj_properties(mo), name);
+    return map_prop_f32_h(map_obj_properties(mo), h);
 }
 
-bool32 map_obj_bool(map_obj_s *mo, const char *name)
+bool32 map_obj_bool_h(map_obj_s *mo, u32 h)
 {
-    return map_prop_bool(map_obj_properties(mo), name);
+    return map_prop_i32_h(map_obj_properties(mo), h);
 }
 
-v2_i16 map_obj_pt(map_obj_s *mo, const char *name)
+v2_i16 map_obj_pt_h(map_obj_s *mo, u32 h)
 {
-    return map_prop_pt(map_obj_properties(mo), name);
+    return map_prop_pt_h(map_obj_properties(mo), h);
 }
 
-void *map_obj_arr(map_obj_s *mo, const char *name, i32 *num)
+void *map_obj_arr_h(map_obj_s *mo, u32 h, i32 *num)
 {
-    map_prop_s *prop = map_prop_get(map_obj_properties(mo), name);
+    map_prop_s *prop = map_prop_get(map_obj_properties(mo), h);
     if (!prop || prop->type != MAP_PROP_ARRAY) return 0;
     *num = prop->u.n;
     return (prop + 1);
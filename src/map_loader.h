@@ -8,6 +8,7 @@
 #include "gamedef.h"
 #include "tile_types.h"
 #include "util/lz.h"
+#include "util/str.h"
 
 typedef struct map_obj_s {
     u32 UID;
@@ -24,14 +25,25 @@ typedef struct map_obj_s {
     u8  th;
 } map_obj_s;
 
-#define map_obj_strs(MO, NAME, B) map_obj_str(MO, NAME, B, sizeof(B))
-bool32     map_obj_has_nonnull_prop(map_obj_s *mo, const char *name);
-bool32     map_obj_str(map_obj_s *mo, const char *name, void *b, u32 bs);
-i32        map_obj_i32(map_obj_s *mo, const char *name);
-f32        map_obj_f32(map_obj_s *mo, const char *name);
-bool32     map_obj_bool(map_obj_s *mo, const char *name);
-v2_i16     map_obj_pt(map_obj_s *mo, const char *name);
-void      *map_obj_arr(map_obj_s *mo, const char *name, i32 *num);
+// property names are string literals hashed at compile time;
+// lookups go through a per room index built on map load
+#define MAP_PROP_HASH(NAME)                 HASH_STR16_LIT(NAME)
+#define map_obj_strs(MO, NAME, B)           map_obj_str(MO, NAME, B, sizeof(B))
+#define map_obj_has_nonnull_prop(MO, NAME)  map_obj_has_nonnull_prop_h(MO, MAP_PROP_HASH(NAME))
+#define map_obj_str(MO, NAME, B, BS)        map_obj_str_h(MO, MAP_PROP_HASH(NAME), B, BS)
+#define map_obj_i32(MO, NAME)               map_obj_i32_h(MO, MAP_PROP_HASH(NAME))
+#define map_obj_f32(MO, NAME)               map_obj_f32_h(MO, MAP_PROP_HASH(NAME))
+#define map_obj_bool(MO, NAME)              map_obj_bool_h(MO, MAP_PROP_HASH(NAME))
+#define map_obj_pt(MO, NAME)                map_obj_pt_h(MO, MAP_PROP_HASH(NAME))
+#define map_obj_arr(MO, NAME, NUM)          map_obj_arr_h(MO, MAP_PROP_HASH(NAME), NUM)
+bool32     map_obj_has_nonnull_prop_h(map_obj_s *mo, u32 h);
+bool32     map_obj_str_h(map_obj_s *mo, u32 h, void *b, u32 bs);
+i32        map_obj_i32_h(map_obj_s *mo, u32 h);
+f32        map_obj_f32_h(map_obj_s *mo, u32 h);
+bool32     map_obj_bool_h(map_obj_s *mo, u32 h);
+v2_i16     map_obj_pt_h(map_obj_s *mo, u32 h);
+void      *map_obj_arr_h(map_obj_s *mo, u32 h, i32 *num);
+void       map_obj_parse_init();
 void       map_obj_parse(g_s *g, map_obj_s *o);
 void       game_load_map(g_s *g, u8 *map_name);
 map_obj_s *map_obj_find(g_s *g, const char *name);
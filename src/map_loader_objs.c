@@ -6,158 +6,180 @@
 
 void map_obj_load_misc(g_s *g, map_obj_s *mo);
 
+typedef void (*map_obj_load_f)(g_s *g, map_obj_s *mo);
+
+typedef struct {
+    const char    *name;
+    map_obj_load_f f;
+} map_obj_loader_s;
+
+static void map_obj_load_heartpiece(g_s *g, map_obj_s *mo)
+{
+    heart_or_stamina_piece_load(g, mo, 0);
+}
+
+static void map_obj_load_staminapiece(g_s *g, map_obj_s *mo)
+{
+    heart_or_stamina_piece_load(g, mo, 1);
+}
+
+static void map_obj_load_cam(g_s *g, map_obj_s *mo)
+{
+    cam_s *cam    = &g->cam;
+    cam->locked_x = map_obj_bool(mo, "locked_x");
+    cam->locked_y = map_obj_bool(mo, "locked_y");
+}
+
+static void map_obj_load_fluid(g_s *g, map_obj_s *mo)
+{
+    rec_i32 rfluid = {mo->x, mo->y, mo->w, mo->h};
+    i32     type   = map_obj_bool(mo, "lava") ? FLUID_AREA_LAVA
+                                              : FLUID_AREA_WATER;
+    fluid_area_create(g, rfluid, type, map_obj_bool(mo, "surface"));
+}
+
+static void map_obj_load_save_point(g_s *g, map_obj_s *mo)
+{
+    v2_i32 ds                          = {mo->x + mo->w / 2, mo->y + mo->h};
+    g->save_points[g->n_save_points++] = ds;
+}
+
+static void map_obj_load_cam_rec(g_s *g, map_obj_s *mo)
+{
+    obj_s *o = obj_create(g);
+    o->ID    = OBJID_CAM_REC;
+    o->subID = map_obj_i32(mo, "ID");
+    o->pos.x = mo->x;
+    o->pos.y = mo->y;
+    o->w     = mo->w;
+    o->h     = mo->h;
+}
+
+static void map_obj_load_saveroom(g_s *g, map_obj_s *mo)
+{
+    obj_s *oo           = obj_create(g);
+    oo->render_priority = RENDER_PRIO_OWL + 1;
+    oo->n_sprites       = 1;
+    obj_place_to_map_obj(oo, mo, 0, +1);
+    obj_sprite_s *spr = &oo->sprites[0];
+    if (mo->hash == hash_str("saveroom_hero")) {
+        spr->trec   = asset_texrec(TEXID_SAVEROOM, 0, 0, 64, 32);
+        spr->offs.x = -32;
+        spr->offs.y = -32;
+    } else {
+        spr->trec   = asset_texrec(TEXID_SAVEROOM, 64, 0, 64, 32);
+        spr->offs.x = -32;
+        spr->offs.y = -32;
+    }
+}
+
+// loader by object type name
+static const map_obj_loader_s g_map_obj_loaders[] = {
+    {"misc", map_obj_load_misc},
+    {"gempile", gempile_load},
+    {"heartpiece", map_obj_load_heartpiece},
+    {"staminapiece", map_obj_load_staminapiece},
+    {"frog", frog_on_load},
+    {"drillerspawn_u", drillerspawn_load},
+    {"drillerspawn_d", drillerspawn_load},
+    {"drillerspawn_l", drillerspawn_load},
+    {"drillerspawn_r", drillerspawn_load},
+    {"shortcutblock", shortcutblock_load},
+    {"multitrigger", multitrigger_load},
+    {"solidlever", solidlever_load},
+    {"rotor", rotor_load},
+    {"savepoint", savepoint_load},
+    {"vineblockade_hor", vineblockade_load},
+    {"vineblockade_ver", vineblockade_load},
+    {"lever_pushpull_hor", leverpushpull_load},
+    {"mushroom", mushroom_load},
+    {"door", door_load},
+    {"jumper", jumper_load},
+    {"tutorialtext", tutorialtext_load},
+    {"crackblock", crackblock_load},
+    {"trampoline", trampoline_load},
+    {"lookahead", lookahead_load},
+    {"bombplant", bombplant_load},
+    {"windarea_u", windarea_load},
+    {"windarea_d", windarea_load},
+    {"windarea_l", windarea_load},
+    {"windarea_r", windarea_load},
+    {"pulleyblock_parent", pulleyblock_load_parent},
+    {"pulleyblock_child", pulleyblock_load_child},
+    {"springyblock", springyblock_load},
+    {"waterleaf", waterleaf_load},
+    {"chest", chest_load},
+    {"fallingblock", fallingblock_load},
+    {"fallingstone", fallingstonespawn_load},
+    {"light", light_load},
+    {"crab", crab_load},
+    {"stompfloor", stompable_block_load},
+    {"staminarestorer", staminarestorer_load},
+    {"flyblob", flyblob_load},
+    {"switch", switch_load},
+    {"budplant", budplant_load},
+    {"steamplatform", steam_platform_load},
+    {"upgradetree", upgradetree_load},
+    {"npc", npc_load},
+    {"crawler", crawler_load},
+    {"pushblock", pushblock_load},
+    {"toggleblock", mushroomblock_load},
+    {"crumbleblock", crumbleblock_load},
+    {"teleport", teleport_load},
+    {"stalactite", stalactite_load},
+    {"flyer", flyer_load},
+    {"movingblock", movingblock_load},
+    {"clockpulse", clockpulse_load},
+    {"triggerarea", triggerarea_load},
+    {"hooklever", hooklever_load},
+    {"cam_attractor", camattractor_load},
+    {"battleroom", battleroom_load},
+    {"cam", map_obj_load_cam},
+    {"fluid", map_obj_load_fluid},
+    {"puppet_comp", map_obj_load_save_point},
+    {"demosave", map_obj_load_save_point},
+    {"cam_rec", map_obj_load_cam_rec},
+    {"saveroom_hero", map_obj_load_saveroom},
+    {"saveroom_comp", map_obj_load_saveroom}};
+
+#define MAP_OBJ_LOADERS_HT_SIZE 256 // power of 2, at least twice the loaders
+static_assert(ARRLEN(g_map_obj_loaders) * 2 <= MAP_OBJ_LOADERS_HT_SIZE, "loader hash table size");
+
+typedef struct {
+    u32 hash; // hash of the type name
+    u8  i;    // loader index + 1, 0 if empty
+} map_obj_loader_slot_s;
+
+static map_obj_loader_slot_s g_map_obj_loaders_ht[MAP_OBJ_LOADERS_HT_SIZE];
+
+void map_obj_parse_init()
+{
+    mclr_static_arr(g_map_obj_loaders_ht);
+    for (i32 n = 0; n < (i32)ARRLEN(g_map_obj_loaders); n++) {
+        u32 h = hash_str(g_map_obj_loaders[n].name);
+        u32 k = h;
+        for (; g_map_obj_loaders_ht[k & (MAP_OBJ_LOADERS_HT_SIZE - 1)].i; k++) {
+            map_obj_loader_slot_s *sl = &g_map_obj_loaders_ht[k & (MAP_OBJ_LOADERS_HT_SIZE - 1)];
+            if (sl->hash == h) { // duplicate name or colliding hash: only the first would ever load
+                pltf_log("map obj loader hash collision: %s | %s\n",
+                         g_map_obj_loaders[sl->i - 1].name, g_map_obj_loaders[n].name);
+                BAD_PATH();
+            }
+        }
+        map_obj_loader_slot_s *sl = &g_map_obj_loaders_ht[k & (MAP_OBJ_LOADERS_HT_SIZE - 1)];
+        sl->hash                  = h;
+        sl->i                     = (u8)(n + 1);
+    }
+}
+
 void map_obj_parse(g_s *g, map_obj_s *mo)
 {
-    if (0) {
-    } else if (mo->hash == hash_str("misc")) {
-        map_obj_load_misc(g, mo);
-    } else if (mo->hash == hash_str("gempile")) {
-        gempile_load(g, mo);
-    } else if (mo->hash == hash_str("heartpiece")) {
-        heart_or_stamina_piece_load(g, mo, 0);
-    } else if (mo->hash == hash_str("staminapiece")) {
-        heart_or_stamina_piece_load(g, mo, 1);
-    } else if (mo->hash == hash_str("frog")) {
-        frog_on_load(g, mo);
-    } else if (mo->hash == hash_str("drillerspawn_u") ||
-               mo->hash == hash_str("drillerspawn_d") ||
-               mo->hash == hash_str("drillerspawn_l") ||
-               mo->hash == hash_str("drillerspawn_r")) {
-        drillerspawn_load(g, mo);
-    } else if (mo->hash == hash_str("shortcutblock")) {
-        shortcutblock_load(g, mo);
-    } else if (mo->hash == hash_str("multitrigger")) {
-        multitrigger_load(g, mo);
-    } else if (mo->hash == hash_str("solidlever")) {
-        solidlever_load(g, mo);
-    } else if (mo->hash == hash_str("rotor")) {
-        rotor_load(g, mo);
-    } else if (mo->hash == hash_str("savepoint")) {
-        savepoint_load(g, mo);
-    } else if (mo->hash == hash_str("vineblockade_hor") ||
-               mo->hash == hash_str("vineblockade_ver")) {
-        vineblockade_load(g, mo);
-    } else if (mo->hash == hash_str("lever_pushpull_hor")) {
-        leverpushpull_load(g, mo);
-    } else if (mo->hash == hash_str("mushroom")) {
-        mushroom_load(g, mo);
-    } else if (mo->hash == hash_str("door")) {
-        door_load(g, mo);
-    } else if (mo->hash == hash_str("jumper")) {
-        jumper_load(g, mo);
-    } else if (mo->hash == hash_str("tutorialtext")) {
-        tutorialtext_load(g, mo);
-    } else if (mo->hash == hash_str("crackblock")) {
-        crackblock_load(g, mo);
-    } else if (mo->hash == hash_str("trampoline")) {
-        trampoline_load(g, mo);
-    } else if (mo->hash == hash_str("lookahead")) {
-        lookahead_load(g, mo);
-    } else if (mo->hash == hash_str("bombplant")) {
-        bombplant_load(g, mo);
-    } else if (mo->hash == hash_str("windarea_u") ||
-               mo->hash == hash_str("windarea_d") ||
-               mo->hash == hash_str("windarea_l") ||
-               mo->hash == hash_str("windarea_r")) {
-        windarea_load(g, mo);
-    } else if (mo->hash == hash_str("pulleyblock_parent")) {
-        pulleyblock_load_parent(g, mo);
-    } else if (mo->hash == hash_str("pulleyblock_child")) {
-        pulleyblock_load_child(g, mo);
-    } else if (mo->hash == hash_str("springyblock")) {
-        springyblock_load(g, mo);
-    } else if (mo->hash == hash_str("waterleaf")) {
-        waterleaf_load(g, mo);
-    } else if (mo->hash == hash_str("chest")) {
-        chest_load(g, mo);
-    } else if (mo->hash == hash_str("fallingblock")) {
-        fallingblock_load(g, mo);
-    } else if (mo->hash == hash_str("fallingstone")) {
-        fallingstonespawn_load(g, mo);
-    } else if (mo->hash == hash_str("light")) {
-        light_load(g, mo);
-    } else if (mo->hash == hash_str("crab")) {
-        crab_load(g, mo);
-    } else if (mo->hash == hash_str("stompfloor")) {
-        stompable_block_load(g, mo);
-    } else if (mo->hash == hash_str("staminarestorer")) {
-        staminarestorer_load(g, mo);
-    } else if (mo->hash == hash_str("flyblob")) {
-        flyblob_load(g, mo);
-    } else if (mo->hash == hash_str("switch")) {
-        switch_load(g, mo);
-    } else if (mo->hash == hash_str("budplant")) {
-        budplant_load(g, mo);
-    } else if (mo->hash == hash_str("steamplatform")) {
-        steam_platform_load(g, mo);
-    } else if (mo->hash == hash_str("upgradetree")) {
-        upgradetree_load(g, mo);
-    } else if (mo->hash == hash_str("npc")) {
-        npc_load(g, mo);
-    } else if (mo->hash == hash_str("crawler")) {
-        crawler_load(g, mo);
-    } else if (mo->hash == hash_str("pushblock")) {
-        pushblock_load(g, mo);
-    } else if (mo->hash == hash_str("toggleblock")) {
-        mushroomblock_load(g, mo);
-    } else if (mo->hash == hash_str("crumbleblock")) {
-        crumbleblock_load(g, mo);
-    } else if (mo->hash == hash_str("teleport")) {
-        teleport_load(g, mo);
-    } else if (mo->hash == hash_str("stalactite")) {
-        stalactite_load(g, mo);
-    } else if (mo->hash == hash_str("flyer")) {
-        flyer_load(g, mo);
-    } else if (mo->hash == hash_str("movingblock")) {
-        movingblock_load(g, mo);
-    } else if (mo->hash == hash_str("clockpulse")) {
-        clockpulse_load(g, mo);
-    } else if (mo->hash == hash_str("triggerarea")) {
-        triggerarea_load(g, mo);
-    } else if (mo->hash == hash_str("hooklever")) {
-        hooklever_load(g, mo);
-    } else if (mo->hash == hash_str("cam_attractor")) {
-        camattractor_load(g, mo);
-    } else if (mo->hash == hash_str("battleroom")) {
-        battleroom_load(g, mo);
-    } else if (mo->hash == hash_str("cam")) {
-        cam_s *cam    = &g->cam;
-        cam->locked_x = map_obj_bool(mo, "locked_x");
-        cam->locked_y = map_obj_bool(mo, "locked_y");
-    } else if (mo->hash == hash_str("fluid")) {
-        rec_i32 rfluid = {mo->x, mo->y, mo->w, mo->h};
-        i32     type   = map_obj_bool(mo, "lava") ? FLUID_AREA_LAVA
-                                                  : FLUID_AREA_WATER;
-        fluid_area_create(g, rfluid, type, map_obj_bool(mo, "surface"));
-    } else if (mo->hash == hash_str("puppet_comp")) {
-        v2_i32 ds                          = {mo->x + mo->w / 2, mo->y + mo->h};
-        g->save_points[g->n_save_points++] = ds;
-    } else if (mo->hash == hash_str("demosave")) {
-        v2_i32 ds                          = {mo->x + mo->w / 2, mo->y + mo->h};
-        g->save_points[g->n_save_points++] = ds;
-    } else if (mo->hash == hash_str("cam_rec")) {
-        obj_s *o = obj_create(g);
-        o->ID    = OBJID_CAM_REC;
-        o->subID = map_obj_i32(mo, "ID");
-        o->pos.x = mo->x;
-        o->pos.y = mo->y;
-        o->w     = mo->w;
-        o->h     = mo->h;
-    } else if (mo->hash == hash_str("saveroom_hero") ||
-               mo->hash == hash_str("saveroom_comp")) {
-        obj_s *oo           = obj_create(g);
-        oo->render_priority = RENDER_PRIO_OWL + 1;
-        oo->n_sprites       = 1;
-        obj_place_to_map_obj(oo, mo, 0, +1);
-        obj_sprite_s *spr = &oo->sprites[0];
-        if (mo->hash == hash_str("saveroom_hero")) {
-            spr->trec   = asset_texrec(TEXID_SAVEROOM, 0, 0, 64, 32);
-            spr->offs.x = -32;
-            spr->offs.y = -32;
-        } else {
-            spr->trec   = asset_texrec(TEXID_SAVEROOM, 64, 0, 64, 32);
-            spr->offs.x = -32;
-            spr->offs.y = -32;
+    for (u32 k = mo->hash;; k++) {
+        map_obj_loader_slot_s *sl = &g_map_obj_loaders_ht[k & (MAP_OBJ_LOADERS_HT_SIZE - 1)];
+        if (!sl->i) break;
+        if (sl->hash == mo->hash) {
+            g_map_obj_loaders[sl->i - 1].f(g, mo);
+            break;
         }
     }
 }
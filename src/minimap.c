@@ -10,6 +10,8 @@
 #define MINIMAP_TICKS_FADE_IN  8
 #define MINIMAP_TICKS_FADE_OUT 8
 #define MINIMAP_GRAV_DISTSQ    100
+#define MINIMAP_CACHE_W        512 // composited map around the view
+#define MINIMAP_CACHE_H        320
 
 v2_i32 minimap_hero_pos(g_s *g);
 bool32 minimap_try_grav_to_hovered_pin(minimap_s *m);
@@ -34,6 +36,7 @@ void minimap_open_internal(g_s *g, i32 state)
     m->pin_deny_tick = 0;
     m->pin_ui_fade   = 0;
     m->state         = state;
+    m->cache_valid   = 0;
     mset(m->visited, 0xFF, sizeof(m->visited));
 }
 
@@ -162,21 +165,27 @@ void minimap_update(g_s *g)
     }
 }
 
-void minimap_draw_at(tex_s tex, g_s *g, i32 ox, i32 oy, b32 menu)
+// composites rooms, hidden screens and room borders into the cache texture
+// for the window at cache_x/cache_y (world coordinates)
+void minimap_cache_build(g_s *g)
 {
     minimap_s *m            = &g->minimap;
-    gfx_ctx_s  ctx          = gfx_ctx_from_tex(tex);
+    gfx_ctx_s  ctx          = gfx_ctx_from_tex(m->cache);
     gfx_ctx_s  ctxr         = ctx;
     gfx_ctx_s  ctx_obscured = ctx;
-    ctxr.pat                = gfx_pattern_50();
+    i32        ox           = -m->cache_x;
+    i32        oy           = -m->cache_y;
+    ctxr.pat                = gfx_pattern_shift(gfx_pattern_50(), ox & 1, oy & 1);
     ctx_obscured.pat        = gfx_pattern_shift(gfx_pattern_bayer_4x4(15), ox & 3, oy & 3);
+    rec_i32 rwin            = {m->cache_x, m->cache_y, m->cache.w, m->cache.h};
     tex_clr(ctx.dst, GFX_COL_BLACK);
 
-    // map images
-
     // images and hding rects
     for (i32 n = 0; n < g->n_map_rooms; n++) {
-        map_room_s *mr     = &g->map_rooms[n];
+        map_room_s *mr = &g->map_rooms[n];
+        rec_i32     rr = {mr->x, mr->y, mr->w + 1, mr->h + 1}; // + border
+        if (!overlap_rec(rwin, rr)) continue;
+
         map_room_s *mr_alt = map_room_find(g, 1, mr->map_name);
         v2_i32      pos    = {mr->x + ox, mr->y + oy};
         gfx_spr(ctx, texrec_from_tex(mr_alt->t), pos, 0, 0);
@@ -198,7 +207,9 @@ void minimap_draw_at(tex_s tex, g_s *g, i32 ox, i32 oy, b32 menu)
     // room borders
     for (i32 n = 0; n < g->n_map_rooms; n++) {
         map_room_s *mr  = &g->map_rooms[n];
+        rec_i32     rr  = {mr->x, mr->y, mr->w + 1, mr->h + 1};
         v2_i32      pos = {mr->x + ox, mr->y + oy};
+        if (!overlap_rec(rwin, rr)) continue;
 
         for (i32 ny = 0; ny < mr->h; ny += 15) {
             i32 sy  = mr->y + ny;
@@ -229,6 +240,30 @@ void minimap_draw_at(tex_s tex, g_s *g, i32 ox, i32 oy, b32 menu)
             }
         }
     }
+    m->cache_valid = 1;
+}
+
+void minimap_draw_at(tex_s tex, g_s *g, i32 ox, i32 oy, b32 menu)
+{
+    minimap_s *m   = &g->minimap;
+    gfx_ctx_s  ctx = gfx_ctx_from_tex(tex);
+
+    // map images: blit the visible window of the composited map,
+    // recomposite if the view left the cached window
+    if (!m->cache.px) {
+        m->cache = tex_create(MINIMAP_CACHE_W, MINIMAP_CACHE_H, 0, app_allocator(), 0);
+    }
+    i32 vx = -ox;
+    i32 vy = -oy;
+    if (!m->cache_valid ||
+        vx < m->cache_x || m->cache_x + MINIMAP_CACHE_W < vx + tex.w ||
+        vy < m->cache_y || m->cache_y + MINIMAP_CACHE_H < vy + tex.h) {
+        m->cache_x = (vx - (MINIMAP_CACHE_W - tex.w) / 2) & ~31; // word aligned blits
+        m->cache_y = vy - (MINIMAP_CACHE_H - tex.h) / 2;
+        minimap_cache_build(g);
+    }
+    v2_i32 pcache = {m->cache_x + ox, m->cache_y + oy};
+    gfx_spr(ctx, texrec_from_tex(m->cache), pcache, 0, 0);
 
     obj_s *ohero = obj_get_owl(g);
 
@@ -424,8 +459,11 @@ void minimap_confirm_visited(g_s *g)
     minimap_s *m = &g->minimap;
 
     for (i32 n = 0; n < ARRLEN(m->visited); n += 2) {
-        m->visited[n + MINIMAP_SCREEN_INDEX_CONFIRMED] =
-            m->visited[n + MINIMAP_SCREEN_INDEX_VISITED];
+        u32 v = m->visited[n + MINIMAP_SCREEN_INDEX_VISITED];
+        if (m->visited[n + MINIMAP_SCREEN_INDEX_CONFIRMED] != v) {
+            m->visited[n + MINIMAP_SCREEN_INDEX_CONFIRMED] = v;
+            m->cache_valid                                 = 0;
+        }
     }
 }
 
@@ -445,9 +483,13 @@ void minimap_try_visit_screen(g_s *g)
         for (i32 sx = sx1; sx <= sx2; sx++) {
             assert(0 <= sx && sx < MINIMAP_SCREENS_X);
             i32 k = (sx + sy * MINIMAP_SCREENS_X);
-            m->visited[((k >> 5) << 1) + 0] |= (u32)1 << (k & 31);
+            u32 b = (u32)1 << (k & 31);
+            if ((m->visited[((k >> 5) << 1) + 0] & m->visited[((k >> 5) << 1) + 1] & b) == 0) {
+                m->cache_valid = 0; // newly revealed
+            }
+            m->visited[((k >> 5) << 1) + 0] |= b;
 #if 1
-            m->visited[((k >> 5) << 1) + 1] |= (u32)1 << (k & 31);
+            m->visited[((k >> 5) << 1) + 1] |= b;
 #endif
         }
     }
@@ -43,6 +43,10 @@ typedef struct {
     u8  pin_deny_tick;
 
     minimap_pin_s *pin_hovered;
+    tex_s          cache; // composited rooms around the view
+    i32            cache_x;
+    i32            cache_y;
+    b8             cache_valid;
 
     SAVED u8            n_pins;
     SAVED minimap_pin_s pins[MAP_NUM_PINS];
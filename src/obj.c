@@ -29,6 +29,61 @@ bool32 obj_handle_valid(obj_handle_s h)
     return (h.o && h.o->generation == h.generation);
 }
 
+// appends to the tail of a bucket to keep the order stable
+static void obj_render_link(g_s *g, obj_s *o, i32 b)
+{
+    o->render_bucket = b;
+    o->render_next   = 0;
+    o->render_prev   = g->obj_render_tail[b];
+    if (o->render_prev) {
+        o->render_prev->render_next = o;
+    } else {
+        g->obj_render[b] = o;
+    }
+    g->obj_render_tail[b] = o;
+    if (b < OBJ_RENDER_PENDING) {
+        g->obj_render_used[b >> 5] |= (u32)1 << (b & 31);
+    }
+}
+
+static void obj_render_unlink(g_s *g, obj_s *o)
+{
+    i32 b = o->render_bucket;
+    if (o->render_next) {
+        o->render_next->render_prev = o->render_prev;
+    } else {
+        g->obj_render_tail[b] = o->render_prev;
+    }
+    if (o->render_prev) {
+        o->render_prev->render_next = o->render_next;
+    } else {
+        g->obj_render[b] = o->render_next;
+    }
+    if (b < OBJ_RENDER_PENDING && !g->obj_render[b]) {
+        g->obj_render_used[b >> 5] &= ~((u32)1 << (b & 31));
+    }
+}
+
+void obj_render_priority_set(g_s *g, obj_s *o, i32 prio)
+{
+    assert(0 <= prio && prio < OBJ_RENDER_PENDING);
+    o->render_priority = prio;
+    if (o->render_bucket == OBJ_RENDER_PENDING) return; // sorted in later
+    if (o->render_bucket == prio) return;
+
+    obj_render_unlink(g, o);
+    obj_render_link(g, o, prio);
+}
+
+void objs_render_flush(g_s *g)
+{
+    obj_s *o;
+    while ((o = g->obj_render[OBJ_RENDER_PENDING])) {
+        obj_render_unlink(g, o);
+        obj_render_link(g, o, o->render_priority);
+    }
+}
+
 obj_s *obj_create(g_s *g)
 {
     obj_s *o = g->obj_head_free;
@@ -37,22 +92,18 @@ obj_s *obj_create(g_s *g)
         return 0;
     }
 
-    g->objrender_dirty              = 1;
-    g->obj_render[g->n_objrender++] = o;
-    g->obj_head_free                = o->next;
+    g->obj_head_free = o->next;
 
     u32 gen = o->generation;
     mclr_ptr(o);
     o->generation = gen;
-    o->prev       = 0;
-    o->next       = g->obj_head_busy;
-    if (g->obj_head_busy) {
-        g->obj_head_busy->prev = o;
-    }
-    g->obj_head_busy       = o;
-    o->render_priority     = RENDER_PRIO_DEFAULT_OBJ;
-    o->on_squish           = obj_delete;
-    o->on_pushpull_blocked = obj_pushpull_blocked_default;
+
+    o->i_busy                    = g->n_obj_busy;
+    g->obj_busy[g->n_obj_busy++] = o;
+    o->render_priority           = RENDER_PRIO_DEFAULT_OBJ;
+    o->on_squish                 = obj_delete;
+    o->on_pushpull_blocked       = obj_pushpull_blocked_default;
+    obj_render_link(g, o, OBJ_RENDER_PENDING); // priority usually set after creation
 #if PLTF_DEBUG
     o->magic = OBJ_MAGIC;
 #if 0
@@ -92,6 +143,7 @@ bool32 obj_tag(g_s *g, obj_s *o, i32 tag)
 {
     if (g->obj_tag[tag]) return 0;
     g->obj_tag[tag] = o;
+    o->tags |= 1 << tag;
     return 1;
 }
 
@@ -99,6 +151,7 @@ bool32 obj_untag(g_s *g, obj_s *o, i32 tag)
 {
     if (g->obj_tag[tag] != o) return 0;
     g->obj_tag[tag] = 0;
+    o->tags &= ~(1 << tag);
     return 1;
 }
 
@@ -109,33 +162,53 @@ obj_s *obj_get_tagged(g_s *g, i32 tag)
 
 void objs_cull_to_delete(g_s *g)
 {
+    // IDs are assigned right after creation -> index new objects now
+    for (u32 n = g->n_obj_ID_indexed; n < g->n_obj_busy; n++) {
+        obj_s *o = g->obj_busy[n];
+        assert(o->ID < NUM_OBJID);
+        o->ID_prev = 0;
+        o->ID_next = g->obj_ID[o->ID];
+        if (o->ID_next) {
+            o->ID_next->ID_prev = o;
+        }
+        g->obj_ID[o->ID] = o;
+    }
+    g->n_obj_ID_indexed = g->n_obj_busy;
+
+    if (g->obj_ndelete == 0) return;
+
+    // compact the busy array keeping the order
+    u32 n_busy = 0;
+    for (u32 n = 0; n < g->n_obj_busy; n++) {
+        obj_s *o = g->obj_busy[n];
+        if (o->flags_internal & OBJ_IFLAG_TO_DELETE) continue;
+        o->i_busy             = n_busy;
+        g->obj_busy[n_busy++] = o;
+    }
+    g->n_obj_busy       = n_busy;
+    g->n_obj_ID_indexed = n_busy;
+
     for (u32 n = 0; n < g->obj_ndelete; n++) {
         PREFETCH(g->obj_to_delete[n + 1]);
         obj_s *o = g->obj_to_delete[n];
         assert(o->flags_internal & OBJ_IFLAG_TO_DELETE);
 
-        for (u32 k = 0; k < NUM_OBJ_TAGS; k++) {
-            if (g->obj_tag[k] == o) {
+        for (u32 k = 0, tags = o->tags; tags; k++, tags >>= 1) {
+            if (tags & 1) {
+                assert(g->obj_tag[k] == o);
                 g->obj_tag[k] = 0;
             }
         }
 
-        for (u32 k = 0; k < g->n_objrender; k++) {
-            if (g->obj_render[k] == o) {
-                g->obj_render[k]   = g->obj_render[--g->n_objrender];
-                g->objrender_dirty = 1;
-                break;
-            }
-        }
+        obj_render_unlink(g, o);
 
-        if (o->next) {
-            o->next->prev = o->prev;
-        }
-        if (o->prev) {
-            o->prev->next = o->next;
+        if (o->ID_next) {
+            o->ID_next->ID_prev = o->ID_prev;
         }
-        if (g->obj_head_busy == o) {
-            g->obj_head_busy = o->next;
+        if (o->ID_prev) {
+            o->ID_prev->ID_next = o->ID_next;
+        } else {
+            g->obj_ID[o->ID] = o->ID_next;
         }
 
         o->next          = g->obj_head_free;
@@ -478,8 +551,26 @@ void enemy_on_update_die(g_s *g, obj_s *o)
 
 obj_s *obj_find_ID_subID(g_s *g, i32 ID, i32 subID, obj_s *o_from)
 {
-    for (obj_s *o = o_from ? o_from->next : g->obj_head_busy; o; o = o->next) {
-        if (o->ID == ID && (!subID || subID == o->subID)) {
+    assert(0 <= ID && ID < NUM_OBJID);
+    obj_s *o = 0;
+
+    if (o_from && o_from->i_busy < g->n_obj_ID_indexed) {
+        o = o_from->ID_next;
+    } else {
+        // objects created since the last cull are not indexed yet
+        i32 n1 = (i32)g->n_obj_ID_indexed;
+        for (i32 n = (o_from ? o_from->i_busy : g->n_obj_busy) - 1; n1 <= n; n--) {
+            obj_s *i = g->obj_busy[n];
+            if (i->ID == ID && (!subID || subID == i->subID)) {
+                return i;
+            }
+        }
+        o = g->obj_ID[ID];
+    }
+
+    for (; o; o = o->ID_next) {
+        assert(o->ID == ID); // ID changed after creation
+        if (!subID || subID == o->subID) {
             return o;
         }
     }
@@ -497,29 +588,10 @@ bool32 obj_hit_by_rec(obj_s *o, i32 rx, i32 ry, i32 rw, i32 rh)
     return overlap_rec(obj_aabb(o), r);
 }
 
-// sample circles along ray and check if aabb overlaps any
+// ray with radius (capsule) against the aabb
 bool32 obj_hit_by_ray(obj_s *o, i32 p0x, i32 p0y, i32 p1x, i32 p1y, i32 cr)
 {
-    i32 l         = distance_appr_i32(p0x, p0y, p1x, p1y);
-    i32 n_samples = clamp_i32((l << 1) / cr, 2, 32);
-
-    i32 rx1_q2 = (o->pos.x) << 2;
-    i32 ry1_q2 = (o->pos.y) << 2;
-    i32 rx2_q2 = (o->pos.x + o->w) << 2;
-    i32 ry2_q2 = (o->pos.y + o->h) << 2;
-    i32 c0x_q2 = p0x << 2;
-    i32 c0y_q2 = p0y << 2;
-    i32 c1x_q2 = p1x << 2;
-    i32 c1y_q2 = p1y << 2;
-    i32 cr2_q2 = (cr * cr) << 2;
-
-    for (i32 n = 0; n < n_samples; n++) {
-        i32 cx_q2 = lerp_i32(c0x_q2, c1x_q2, n, n_samples - 1);
-        i32 cy_q2 = lerp_i32(c0y_q2, c1y_q2, n, n_samples - 1);
-
-        if (overlap_rec_cir_xyr2(rx1_q2, rx1_q2, rx1_q2, rx1_q2, cx_q2, cy_q2, cr2_q2)) {
-            return 1;
-        }
-    }
-    return 0;
+    v2_i32 p0 = {p0x, p0y};
+    v2_i32 p1 = {p1x, p1y};
+    return overlap_rec_capsule(obj_aabb(o), p0, p1, cr);
 }
@@ -11,8 +11,10 @@
 #include "particle.h"
 #include "wire.h"
 
-#define NUM_OBJ       256
-#define OBJ_MEM_BYTES 512
+#define NUM_OBJ                256
+#define OBJ_RENDER_PENDING     256                      // = number of u8 render priorities; bucket of objects not yet sorted in
+#define NUM_OBJ_RENDER_BUCKETS (OBJ_RENDER_PENDING + 1) // one per render priority + pending
+#define OBJ_MEM_BYTES          512
 
 // internal flags by engine (separate field)
 #define OBJ_IFLAG_TO_DELETE        ((u32)1 << 0)
@@ -125,17 +127,33 @@ typedef struct enemy_s {
 
 #define OBJ_MAGIC U32_C(0xABABABAB)
 
+static_assert(NUM_OBJ_TAGS <= 8, "obj_s tags bitset");
+
 struct obj_s {
+    // hot: read by the per tick walks over all objects;
+    // exactly one 32 byte line with 4 byte pointers
+    ALIGNAS(32)
+    obj_s *next;               // 4 - 4  free list
+    u16    i_busy;             // 2 - 6  index in g->obj_busy
+    u16    subID;              // 2 - 8  subtype of object
+    u32    flags;              // 4 - 12
+    u16    ID;                 // 2 - 14 type of object
+    u16    moverflags;         // 2 - 16
+    v2_i32 pos;                // 8 - 24 position in pixels
+    i16    w;                  // 2 - 26
+    i16    h;                  // 2 - 28
+    u16    hitbox_flags_group; // 2 - 30
+
     ALIGNAS(32)
-    obj_s *next;           // 4 - 4  main linked list
-    obj_s *prev;           // 4 - 8  main linked list
-    u32    flags_internal; // 4 - 12
-    u32    flags;          // 4 - 16
-    u16    ID;             // 2 - 18 type of object
-    u16    subID;          // 2 - 20 subtype of object
-    u32    generation;     // 4 - 24 how often this object was instantiated
-    u32    editorUID;      // 4 - 28 unique map editorID
+    v2_i32 v_q12;          // 8 - 8
+    v2_i32 subpos_q12;     // 8 - 16 subpixel used for movement; more like an accumulator
+    v2_i32 ppos;           // 8 - 24 position in pixels
+    u32    flags_internal; // 4 - 28
+    u32    generation;     // 4 - 32 how often this object was instantiated
 
+    // cold
+    ALIGNAS(32)
+    u32                    editorUID;           // unique map editorID
     obj_action_f           on_update;           // void f(g_s *g, obj_s *o);
     obj_action_f           on_animate;          // void f(g_s *g, obj_s *o);
     obj_draw_f             on_draw;             // void f(g_s *g, obj_s *o, v2_i32 cam);
@@ -151,19 +169,10 @@ struct obj_s {
     obj_pushed_by_solid_f  on_pushed_by_solid;  // void f(g_s *g, obj_s *o, obj_s *osolid, i32 sx, i32 sy);
     obj_action_f           on_carried_removed;  // void f(g_s *g, obj_s *o);
 
-    ALIGNAS(32)
-    v2_i32 pos;  // position in pixels
-    v2_i32 ppos; // position in pixels
-    i16    w;
-    i16    h;
-    v2_i32 subpos_q12; // subpixel used for movement; more like an accumulator
-    v2_i32 v_q12;
-
     i32 steer_v_max_q12;
 
     // some generic behaviour fields
     u16              bumpflags; // has to be cleared manually
-    u16              moverflags;
     i16              state;
     i16              substate;
     i16              action;
@@ -172,7 +181,9 @@ struct obj_s {
     i32              subtimer;
     i16              cam_attract_r;
     i8               facing; // -1 left, +1 right
-    u8               render_priority;
+    u8               render_priority; // change with obj_render_priority_set after creation
+    u16              render_bucket;
+    u8               tags; // bitset of OBJ_TAG_ held by this object
     i16              health;
     i16              health_max;
     u8               light_radius;
@@ -184,6 +195,10 @@ struct obj_s {
     enemy_s          enemy;
     obj_handle_s     linked_solid;
     particle_emit_s *emitter;
+    obj_s           *render_next; // render bucket list
+    obj_s           *render_prev; // render bucket list
+    obj_s           *ID_next;     // ID bucket list, newest to oldest
+    obj_s           *ID_prev;     // ID bucket list
 
     ALIGNAS(32)
     u8           n_sprites;
@@ -191,7 +206,6 @@ struct obj_s {
 
     ALIGNAS(32)
     u32             hitboxUID_registered[OBJ_NUM_HITBOXID];
-    u16             hitbox_flags_group;
     u16             n_hitboxUID_registered;
     obj_on_hitbox_f on_hitbox;
 
@@ -223,6 +237,8 @@ bool32       obj_tag(g_s *g, obj_s *o, i32 tag);
 bool32       obj_untag(g_s *g, obj_s *o, i32 tag);
 obj_s       *obj_get_tagged(g_s *g, i32 tag);
 void         objs_cull_to_delete(g_s *g); // removes all flagged objects
+void         obj_render_priority_set(g_s *g, obj_s *o, i32 prio);
+void         objs_render_flush(g_s *g); // sorts newly created objects into their render buckets
 bool32       overlap_obj(obj_s *a, obj_s *b);
 rec_i32      obj_aabb(obj_s *o);
 rec_i32      obj_rec_left(obj_s *o);
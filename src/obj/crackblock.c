@@ -202,6 +202,8 @@ void crackblock_break(g_s *g, obj_s *o)
     for (i32 y = 0; y < ny; y++) {
         mclr(&g->tiles[(px) + (py + y) * g->tiles_x], sizeof(tile_s) * nx);
     }
+    tile_map_corners_dirty(g, px, py, px + nx - 1, py + ny - 1);
+    tile_map_solid_bits_update(g, px, py, px + nx - 1, py + ny - 1);
     autotile_terrain_section(g->tiles, g->tiles_x, g->tiles_y, 0, 0,
                              px - 2, py - 2, nx + 4, ny + 4);
     game_on_trigger(g, b->trigger_on_destroy);
@@ -74,17 +74,16 @@ static void mushroomblock_set_state(g_s *g, obj_s *o, i32 state)
         o->flags &= ~OBJ_FLAG_SOLID;
         o->flags &= ~OBJ_FLAG_CLIMBABLE;
         o->flags &= ~OBJ_FLAG_HOOKABLE;
-        o->render_priority = RENDER_PRIO_BEHIND_TERRAIN_LAYER - 1;
+        obj_render_priority_set(g, o, RENDER_PRIO_BEHIND_TERRAIN_LAYER - 1);
         break;
     default:
         o->flags |= OBJ_FLAG_SOLID;
         o->flags |= OBJ_FLAG_CLIMBABLE;
         o->flags |= OBJ_FLAG_HOOKABLE;
         game_on_solid_appear_ext(g, o);
-        o->render_priority = RENDER_PRIO_OWL + 1;
+        obj_render_priority_set(g, o, RENDER_PRIO_OWL + 1);
         break;
     }
-    g->objrender_dirty = 1;
 }
 
 void mushroomblock_on_trigger(g_s *g, obj_s *o, i32 trigger)
@@ -97,5 +97,7 @@ void shortcutblock_set(g_s *g, obj_s *o, i32 state)
         break;
     }
     }
+    tile_map_corners_dirty(g, px, py, px + nx - 1, py + ny - 1);
+    tile_map_solid_bits_update(g, px, py, px + nx - 1, py + ny - 1);
     autotile_terrain_section_game(g, px, py, nx, ny);
 }
\ No newline at end of file
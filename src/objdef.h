@@ -96,6 +96,8 @@ enum {
     OBJID_BOSS_PLANT_EYE,
     OBJID_BOSS_PLANT_EYE_FAKE_L,
     OBJID_BOSS_PLANT_EYE_FAKE_R,
+    //
+    NUM_OBJID
 };
 
 enum {
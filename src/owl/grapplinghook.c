@@ -180,13 +180,64 @@ bool32 grapplinghook_try_attach(g_s *g, grapplinghook_s *h, obj_s *o)
     return 0;
 }
 
-bool32 grapplinghook_step_obj(g_s *g, grapplinghook_s *h, obj_s *o, i32 sx, i32 sy)
+// keeps the earlier of hit and the terrain hit of the ray from x/y
+static void grapplinghook_ray_min(g_s *g, i32 x, i32 y, i32 dx, i32 dy,
+                                  tile_map_ray_hit_s *hit)
+{
+    v2_i32             p0 = {x, y};
+    v2_i32             p1 = {x + dx, y + dy};
+    tile_map_ray_hit_s h;
+    if (tile_map_raycast(g, p0, p1, &h) && h.t_n * hit->t_d < hit->t_n * h.t_d) {
+        *hit = h;
+    }
+}
+
+// number of bresenham steps of a move by dx/dy before the hook could
+// attach anywhere; positions past that need the per pixel checks
+i32 grapplinghook_steps_free(g_s *g, obj_s *o, i32 dx, i32 dy)
+{
+    i32     n  = abs_i32(dx) + abs_i32(dy);
+    rec_i32 ro = {o->pos.x - 1, o->pos.y - 1, o->w + 2, o->h + 2};
+    rec_i32 r  = {ro.x + min_i32(dx, 0), ro.y + min_i32(dy, 0),
+                  ro.w + abs_i32(dx), ro.h + abs_i32(dy)};
+
+    for (obj_each(g, i)) {
+        if ((i->flags & OBJ_FLAG_SOLID) ||
+            (i->flags & OBJ_FLAG_HOOKABLE_ACTOR) == OBJ_FLAG_HOOKABLE_ACTOR) {
+            if (overlap_rec(r, obj_aabb(i))) return 0;
+        }
+    }
+    if (!tile_map_hookable(g, r)) return n;
+    if (tile_map_hookable(g, ro)) return 0;
+
+    // cast from the leading edges of the attach box, grown by 1 px as the
+    // bresenham positions stray up to 1 px from the line
+    i32                x0  = ro.x - 1;
+    i32                y0  = ro.y - 1;
+    i32                x1  = ro.x + ro.w;
+    i32                y1  = ro.y + ro.h;
+    i32                lx  = dx < 0 ? x0 : x1;
+    i32                ly  = dy < 0 ? y0 : y1;
+    tile_map_ray_hit_s hit = {0};
+
+    hit.t_n = 2; // no hit yet
+    hit.t_d = 1;
+    for (i32 y = y0; dx && y <= y1; y++) {
+        grapplinghook_ray_min(g, lx, y, dx, dy, &hit);
+    }
+    for (i32 x = x0; dy && x <= x1; x++) {
+        if (dx && x == lx) continue;
+        grapplinghook_ray_min(g, x, ly, dx, dy, &hit);
+    }
+    if (hit.t_d < hit.t_n) return n;
+    return (i32)((hit.t_n * n) / hit.t_d);
+}
+
+void grapplinghook_move_obj(g_s *g, obj_s *o, i32 sx, i32 sy)
 {
-    if (grapplinghook_try_attach(g, h, o)) return 0;
     o->pos.x += sx;
     o->pos.y += sy;
     wirenode_move(g, o->wire, o->wirenode, sx, sy);
-    return 1;
 }
 
 void grapplinghook_update(g_s *g, grapplinghook_s *h)
@@ -222,15 +273,20 @@ void grapplinghook_update(g_s *g, grapplinghook_s *h)
         i32 y  = 0;
 
         // bresenham for a more linear movement
+        // attach checks only where terrain or objects are close
+        i32 n_free = grapplinghook_steps_free(g, o, dx, dy);
+        i32 n      = 0;
         while (x != dx || y != dy) {
             i32 e2 = e << 1;
             if (e2 >= py) {
-                if (!grapplinghook_step_obj(g, h, o, sx, 0)) break;
+                if (n_free <= n++ && grapplinghook_try_attach(g, h, o)) break;
+                grapplinghook_move_obj(g, o, sx, 0);
                 e += py;
                 x += sx;
             }
             if (e2 <= px) {
-                if (!grapplinghook_step_obj(g, h, o, 0, sy)) break;
+                if (n_free <= n++ && grapplinghook_try_attach(g, h, o)) break;
+                grapplinghook_move_obj(g, o, 0, sy);
                 e += px;
                 y += sy;
             }
@@ -5,12 +5,40 @@
 #include "particle.h"
 #include "game.h"
 
+#define PARTICLE_SOA_FIELDS(F) \
+    F(i16, p_x)                \
+    F(i16, p_y)                \
+    F(i16, p_q8_x)             \
+    F(i16, p_q8_y)             \
+    F(i16, v_q8_x)             \
+    F(i16, v_q8_y)             \
+    F(i16, a_q8_x)             \
+    F(i16, a_q8_y)             \
+    F(i16, drag_q8)            \
+    F(u16, ticks)              \
+    F(u16, ticks_max)          \
+    F(particle_s, particles)
+
+static void particle_move(particle_sys_s *pr, i32 i, i32 j)
+{
+#define PARTICLE_MOVE_FIELD(T, A) pr->A[i] = pr->A[j];
+    PARTICLE_SOA_FIELDS(PARTICLE_MOVE_FIELD)
+#undef PARTICLE_MOVE_FIELD
+}
+
+static void particle_swap(particle_sys_s *pr, i32 i, i32 j)
+{
+#define PARTICLE_SWAP_FIELD(T, A) SWAP(T, pr->A[i], pr->A[j]);
+    PARTICLE_SOA_FIELDS(PARTICLE_SWAP_FIELD)
+#undef PARTICLE_SWAP_FIELD
+}
+
 void particle_sys_shuffle(particle_sys_s *pr, i32 n1, i32 n)
 {
     for (i32 k = n - 1; 0 < k; k--) {
         i32 i = n1 + k;
         i32 j = n1 + rngr_i32(k, n - 1);
-        SWAP(particle_s, pr->particles[i], pr->particles[j]);
+        particle_swap(pr, i, j);
     }
 }
 
@@ -46,29 +74,33 @@ void particle_emitter_emit(g_s *g, particle_emit_s *e, i32 n)
     mclr(&pr->particles[pr->n], to_spawn * sizeof(particle_s));
 
     for (i32 k = 0; k < to_spawn; k++) {
-        particle_s *p = &pr->particles[pr->n++];
-
-        p->p.x       = e->p.x + rngsr_sym_i32(&pr->seed, e->p_range.x);
-        p->p.y       = e->p.y + rngsr_sym_i32(&pr->seed, e->p_range.y);
-        p->v_q8.x    = e->v_q8.x + rngsr_sym_i32(&pr->seed, e->v_q8_range.x);
-        p->v_q8.y    = e->v_q8.y + rngsr_sym_i32(&pr->seed, e->v_q8_range.y);
-        p->a_q8.x    = e->a_q8.x + rngsr_sym_i32(&pr->seed, e->a_q8_range.x);
-        p->a_q8.y    = e->a_q8.y + rngsr_sym_i32(&pr->seed, e->a_q8_range.y);
-        p->ticks_max = rngsr_i32(&pr->seed, e->ticks_min, e->ticks_max);
-        p->mode      = e->mode;
-        p->type      = e->type;
-        p->drag      = e->drag;
+        i32         i = pr->n++;
+        particle_s *p = &pr->particles[i];
+
+        pr->p_x[i]       = e->p.x + rngsr_sym_i32(&pr->seed, e->p_range.x);
+        pr->p_y[i]       = e->p.y + rngsr_sym_i32(&pr->seed, e->p_range.y);
+        pr->v_q8_x[i]    = e->v_q8.x + rngsr_sym_i32(&pr->seed, e->v_q8_range.x);
+        pr->v_q8_y[i]    = e->v_q8.y + rngsr_sym_i32(&pr->seed, e->v_q8_range.y);
+        pr->a_q8_x[i]    = e->a_q8.x + rngsr_sym_i32(&pr->seed, e->a_q8_range.x);
+        pr->a_q8_y[i]    = e->a_q8.y + rngsr_sym_i32(&pr->seed, e->a_q8_range.y);
+        pr->ticks_max[i] = rngsr_i32(&pr->seed, e->ticks_min, e->ticks_max);
+        pr->p_q8_x[i]    = 0;
+        pr->p_q8_y[i]    = 0;
+        pr->ticks[i]     = 0;
+        pr->drag_q8[i]   = 256 - e->drag;
+        p->mode          = e->mode;
+        p->type          = e->type;
 
         obj_s *o = obj_from_handle(e->o);
         if (o) {
-            p->p.x += o->pos.x;
-            p->p.y += o->pos.y;
+            pr->p_x[i] += o->pos.x;
+            pr->p_y[i] += o->pos.y;
         }
         if (e->p_range_r) {
             i32 a = (i32)rngs_i32_bound(&pr->seed, 1 << 17);
             i32 r = (i32)rngs_i32_bound(&pr->seed, e->p_range_r);
-            p->p.x += (sin_q15(a) * r) >> 15;
-            p->p.y += (cos_q15(a) * r) >> 15;
+            pr->p_x[i] += (sin_q15(a) * r) >> 15;
+            pr->p_y[i] += (cos_q15(a) * r) >> 15;
         }
 
         switch (e->type & PARTICLE_MASK_TYPE) {
@@ -86,6 +118,51 @@ void particle_emitter_emit(g_s *g, particle_emit_s *e, i32 n)
     }
 }
 
+// one block of one axis: fixed trip count so the compiler can map it
+// onto SIMD lanes where available
+static inline void particle_sys_integrate(i16 *p, i16 *p_q8, i16 *v_q8,
+                                          i16 *a_q8, i16 *drag_q8)
+{
+    for (i32 k = 0; k < PARTICLE_BLOCK_SIZE; k++) {
+        i16 q   = (i16)(p_q8[k] + v_q8[k]);
+        i16 v   = (i16)(v_q8[k] + a_q8[k]);
+        p[k]    = (i16)(p[k] + (q >> 8));
+        p_q8[k] = q & 0xFF;
+        v_q8[k] = (i16)(((i32)v * drag_q8[k]) >> 8);
+    }
+}
+
+static inline bool32 particle_solid(g_s *g, i32 x, i32 y)
+{
+    tile_solid_bits_s *b = &g->solid_bits;
+    return (b->rows ? tile_solid_bits_pt(b, x, y) : tile_map_solid_pt(g, x, y));
+}
+
+// steps the pixels this tick's integration will move by and stops in
+// front of terrain; the position is offset so the integration ends there
+static void particle_bounce(g_s *g, particle_sys_s *pr, i32 i)
+{
+    i32 x  = pr->p_x[i];
+    i32 y  = pr->p_y[i];
+    i32 dx = (i16)(pr->p_q8_x[i] + pr->v_q8_x[i]) >> 8;
+    i32 dy = (i16)(pr->p_q8_y[i] + pr->v_q8_y[i]) >> 8;
+
+    for (i32 m = abs_i32(dx), s = sgn_i32(dx); m; m--, x += s) {
+        if (particle_solid(g, x + s, y)) {
+            pr->bounced[i] |= 1;
+            break;
+        }
+    }
+    for (i32 m = abs_i32(dy), s = sgn_i32(dy); m; m--, y += s) {
+        if (particle_solid(g, x, y + s)) {
+            pr->bounced[i] |= 2;
+            break;
+        }
+    }
+    pr->p_x[i] = (i16)(x - dx);
+    pr->p_y[i] = (i16)(y - dy);
+}
+
 void particle_sys_update(g_s *g)
 {
     particle_sys_s *pr = &g->particle_sys;
@@ -115,50 +192,108 @@ void particle_sys_update(g_s *g)
         }
     }
 
-    for (i32 i = pr->n - 1; 0 <= i; i--) {
-        particle_s *p = &pr->particles[i];
-        p->ticks++;
+    // whole blocks are processed; lanes past n are stale and never read
+    i32 n_lanes = (pr->n + PARTICLE_BLOCK_SIZE - 1) & ~(PARTICLE_BLOCK_SIZE - 1);
 
-        if (p->ticks_max <= p->ticks ||
-            ((p->type & PARTICLE_FLAG_COLLISIONS) &&
-             map_blocked_pt(g, p->p.x, p->p.y))) {
-            *p = pr->particles[--pr->n];
-            continue;
+    for (i32 b = 0; b < n_lanes; b += PARTICLE_BLOCK_SIZE) {
+        for (i32 k = b; k < b + PARTICLE_BLOCK_SIZE; k++) {
+            pr->ticks[k]++;
+            pr->dead[k] = pr->ticks_max[k] <= pr->ticks[k];
         }
+    }
 
-        p->p_q8 = v2_i16_add(p->p_q8, p->v_q8);
-        p->v_q8 = v2_i16_add(p->v_q8, p->a_q8);
-        i32 dx  = p->p_q8.x >> 8;
-        i32 dy  = p->p_q8.y >> 8;
-        p->p_q8.x &= 0xFF;
-        p->p_q8.y &= 0xFF;
-        i32 dr    = 256 - p->drag;
-        p->v_q8.x = (p->v_q8.x * dr) >> 8;
-        p->v_q8.y = (p->v_q8.y * dr) >> 8;
-
-#if 0
-        if (p->type & PARTICLE_FLAG_COLLISIONS) {
-            for (i32 m = abs_i32(dx), s = sgn_i32(dx); m; m--, p->p.x += s) {
-                if (map_blocked_pt(g, p->p.x + s, p->p.y)) {
-                    p->v_q8.x = -p->v_q8.x >> 1;
-                    break;
-                }
-            }
-            for (i32 m = abs_i32(dy), s = sgn_i32(dy); m; m--, p->p.y += s) {
-                if (map_blocked_pt(g, p->p.x, p->p.y + s)) {
-                    p->v_q8.y = -p->v_q8.y >> 1;
-                    break;
-                }
-            }
-        } else {
-            p->p.x += dx;
-            p->p.y += dy;
+    // collisions are tested against the position before integration
+    for (i32 i = 0; i < pr->n; i++) {
+        i32 type       = pr->particles[i].type;
+        pr->bounced[i] = 0;
+        if (pr->dead[i]) continue;
+
+        if ((type & PARTICLE_FLAG_COLLISIONS) &&
+            particle_solid(g, pr->p_x[i], pr->p_y[i])) {
+            pr->dead[i] = 1;
+        } else if (type & PARTICLE_FLAG_BOUNCE) {
+            particle_bounce(g, pr, i);
         }
-#else
-        p->p.x += dx;
-        p->p.y += dy;
-#endif
     }
+
+    for (i32 b = 0; b < n_lanes; b += PARTICLE_BLOCK_SIZE) {
+        particle_sys_integrate(pr->p_x + b, pr->p_q8_x + b, pr->v_q8_x + b,
+                               pr->a_q8_x + b, pr->drag_q8 + b);
+        particle_sys_integrate(pr->p_y + b, pr->p_q8_y + b, pr->v_q8_y + b,
+                               pr->a_q8_y + b, pr->drag_q8 + b);
+    }
+
+    for (i32 i = 0; i < pr->n; i++) {
+        if (pr->bounced[i] & 1) {
+            pr->v_q8_x[i] = -pr->v_q8_x[i] >> 1;
+        }
+        if (pr->bounced[i] & 2) {
+            pr->v_q8_y[i] = -pr->v_q8_y[i] >> 1;
+        }
+    }
+
+    // swap remove back to front: the moved particle was already checked
+    for (i32 i = pr->n - 1; 0 <= i; i--) {
+        if (pr->dead[i]) {
+            particle_move(pr, i, --pr->n);
+        }
+    }
+}
+
+// draw buckets: particle type x fade level, the last level is unfaded
+#define PARTICLE_FADE_LEVELS  (GFX_PATTERN_NUM + 1)
+#define PARTICLE_DRAW_BUCKETS (PARTICLE_NUM_TYPES * PARTICLE_FADE_LEVELS)
+#define PARTICLE_DRAW_CULLED  0xFF
+
+static_assert(PARTICLE_DRAW_BUCKETS < PARTICLE_DRAW_CULLED, "particle buckets");
+
+static inline i32 particle_size(particle_sys_s *pr, i32 i)
+{
+    particle_s *p = &pr->particles[i];
+    return lerp_i32(p->prim.size_beg, p->prim.size_end,
+                    pr->ticks[i], pr->ticks_max[i]);
+}
+
+// returns the draw bucket of a particle or PARTICLE_DRAW_CULLED
+static i32 particle_draw_bucket(particle_sys_s *pr, i32 i, gfx_ctx_s *ctx, v2_i32 cam)
+{
+    particle_s *p    = &pr->particles[i];
+    i32         type = p->type & PARTICLE_MASK_TYPE;
+    i32         x    = pr->p_x[i] + cam.x;
+    i32         y    = pr->p_y[i] + cam.y;
+    rec_i32     r    = {0};
+
+    switch (type) {
+    case PARTICLE_TYPE_CIR: {
+        i32 d = max_i32(p->prim.size_beg, p->prim.size_end);
+        r     = (rec_i32){x - d, y - d, 2 * d + 1, 2 * d + 1};
+        break;
+    }
+    case PARTICLE_TYPE_REC: {
+        i32 d = max_i32(p->prim.size_beg, p->prim.size_end);
+        r     = (rec_i32){x - (d >> 1), y - (d >> 1), d, d};
+        break;
+    }
+    case PARTICLE_TYPE_TEX: {
+        r = (rec_i32){x, y, (i32)p->tex.w << 3, (i32)p->tex.h << 3};
+        break;
+    }
+    default: return PARTICLE_DRAW_CULLED;
+    }
+
+    if (r.x + r.w <= ctx->clip_x1 || ctx->clip_x2 < r.x ||
+        r.y + r.h <= ctx->clip_y1 || ctx->clip_y2 < r.y) {
+        return PARTICLE_DRAW_CULLED;
+    }
+
+    i32 level = PARTICLE_FADE_LEVELS - 1;
+    if (p->type & PARTICLE_FLAG_FADE_OUT) {
+        // same index as gfx_pattern_interpolate
+        i32 ticks_max = pr->ticks_max[i];
+        i32 num       = ticks_max - pr->ticks[i];
+        level         = clamp_i32((num * GFX_PATTERN_NUM) / ticks_max, 0, GFX_PATTERN_MAX);
+    }
+    return (type * PARTICLE_FADE_LEVELS + level);
 }
 
 void particle_sys_draw(g_s *g, v2_i32 cam)
@@ -166,39 +301,81 @@ void particle_sys_draw(g_s *g, v2_i32 cam)
     particle_sys_s *pr  = &g->particle_sys;
     gfx_ctx_s       ctx = gfx_ctx_display();
     tex_s           tex = asset_tex(TEXID_PARTICLES);
+    if (pr->n == 0) return;
+
+    spm_push();
+    u8  *bucket = spm_alloctn(u8, pr->n);
+    u16 *order  = spm_alloctn(u16, pr->n);
+    i32  offs[PARTICLE_DRAW_BUCKETS + 1];
+    mclr_static_arr(offs);
 
+    // cull and count, then sort visible particles into buckets
+    // keeping their relative order
     for (i32 i = 0; i < pr->n; i++) {
-        particle_s *p    = &pr->particles[i];
-        v2_i32      pos  = v2_i32_add(v2_i32_from_i16(p->p), cam);
-        gfx_ctx_s   ctxp = ctx;
-        if (p->type & PARTICLE_FLAG_FADE_OUT) {
-            ctxp.pat = gfx_pattern_interpolate(p->ticks_max - p->ticks, p->ticks_max);
+        i32 b     = particle_draw_bucket(pr, i, &ctx, cam);
+        bucket[i] = (u8)b;
+        if (b != PARTICLE_DRAW_CULLED) {
+            offs[b + 1]++;
+        }
+    }
+    for (i32 b = 0; b < PARTICLE_DRAW_BUCKETS; b++) {
+        offs[b + 1] += offs[b];
+    }
+    i32 fill[PARTICLE_DRAW_BUCKETS];
+    mcpy(fill, offs, sizeof(fill));
+    for (i32 i = 0; i < pr->n; i++) {
+        if (bucket[i] != PARTICLE_DRAW_CULLED) {
+            order[fill[bucket[i]]++] = (u16)i;
+        }
+    }
+
+    for (i32 b = 0; b < PARTICLE_DRAW_BUCKETS; b++) {
+        i32 k1 = offs[b];
+        i32 k2 = offs[b + 1];
+        if (k1 == k2) continue;
+
+        i32       type  = b / PARTICLE_FADE_LEVELS;
+        i32       level = b % PARTICLE_FADE_LEVELS;
+        gfx_ctx_s ctxp  = ctx;
+        if (level < GFX_PATTERN_NUM) {
+            ctxp.pat = gfx_pattern_bayer_4x4(level);
         }
 
-        switch (p->type & PARTICLE_MASK_TYPE) {
+        switch (type) {
         case PARTICLE_TYPE_CIR: {
-            i32 s = lerp_i32(p->prim.size_beg, p->prim.size_end,
-                             p->ticks, p->ticks_max);
-            gfx_cir_fill(ctxp, pos, s, p->mode);
+            for (i32 k = k1; k < k2; k++) {
+                i32    i   = order[k];
+                v2_i32 pos = {pr->p_x[i] + cam.x, pr->p_y[i] + cam.y};
+                gfx_cir_fill(ctxp, pos, particle_size(pr, i), pr->particles[i].mode);
+            }
             break;
         }
         case PARTICLE_TYPE_REC: {
-            i32     s = lerp_i32(p->prim.size_beg, p->prim.size_end,
-                                 p->ticks, p->ticks_max);
-            rec_i32 r = {pos.x - (s >> 1), pos.y - (s >> 1), s, s};
-            gfx_rec_fill(ctxp, r, p->mode);
+            for (i32 k = k1; k < k2; k++) {
+                i32     i = order[k];
+                i32     s = particle_size(pr, i);
+                rec_i32 r = {pr->p_x[i] + cam.x - (s >> 1),
+                             pr->p_y[i] + cam.y - (s >> 1), s, s};
+                gfx_rec_fill(ctxp, r, pr->particles[i].mode);
+            }
             break;
         }
         case PARTICLE_TYPE_TEX: {
-            i32      f = lerp_i32(0, p->tex.n_frames, p->ticks, p->ticks_max);
-            texrec_s t = {tex,
-                          (p->tex.x + f * p->tex.w) << 3,
-                          (p->tex.y) << 3,
-                          (p->tex.w) << 3,
-                          (p->tex.h) << 3};
-            gfx_spr(ctxp, t, pos, p->mode, 0);
+            for (i32 k = k1; k < k2; k++) {
+                i32         i   = order[k];
+                particle_s *p   = &pr->particles[i];
+                i32         f   = lerp_i32(0, p->tex.n_frames, pr->ticks[i], pr->ticks_max[i]);
+                v2_i32      pos = {pr->p_x[i] + cam.x, pr->p_y[i] + cam.y};
+                texrec_s    t   = {tex,
+                                   (p->tex.x + f * p->tex.w) << 3,
+                                   (p->tex.y) << 3,
+                                   (p->tex.w) << 3,
+                                   (p->tex.h) << 3};
+                gfx_spr(ctxp, t, pos, p->mode, 0);
+            }
             break;
         }
         }
     }
-}
\ No newline at end of file
+    spm_pop();
+}
@@ -20,7 +20,8 @@ enum {
     //
     PARTICLE_NUM_TYPES,
     //
-    PARTICLE_FLAG_COLLISIONS = 1 << 6,
+    PARTICLE_FLAG_BOUNCE     = 1 << 5, // bounce off terrain
+    PARTICLE_FLAG_COLLISIONS = 1 << 6, // die on contact with terrain
     PARTICLE_FLAG_FADE_OUT   = 1 << 7,
 };
 
@@ -65,32 +66,44 @@ typedef struct {
     v2_i16         a_q8_range;
 } particle_emit_s;
 
+#define NUM_PARTICLES       512
+#define PARTICLE_BLOCK_SIZE 16 // particles integrated per block
+
+// attributes only needed for spawning and drawing
 typedef struct {
-    ALIGNAS(32)
-    v2_i16 p;
-    v2_i16 p_q8;
-    v2_i16 v_q8;
-    v2_i16 a_q8;
-    u16    ticks;
-    u16    ticks_max;
-    u8     type; // type and flags
-    u8     mode; // mode for prim or flipping flags
-    u8     drag;
+    u8 type; // type and flags
+    u8 mode; // mode for prim or flipping flags
     union {
         particle_prim_s prim;
         particle_tex_s  tex;
     };
 } particle_s;
 
-static_assert(sizeof(particle_s) == 32, "size particle");
-
+// simulation data is stored as separate arrays so the integration
+// runs over contiguous i16 lanes in fixed size blocks
 typedef struct {
     u32             seed;
     i32             n;
-    particle_s      particles[512];
+    ALIGNAS(32)
+    i16             p_x[NUM_PARTICLES];
+    i16             p_y[NUM_PARTICLES];
+    i16             p_q8_x[NUM_PARTICLES];
+    i16             p_q8_y[NUM_PARTICLES];
+    i16             v_q8_x[NUM_PARTICLES];
+    i16             v_q8_y[NUM_PARTICLES];
+    i16             a_q8_x[NUM_PARTICLES];
+    i16             a_q8_y[NUM_PARTICLES];
+    i16             drag_q8[NUM_PARTICLES]; // velocity factor: 256 - drag
+    u16             ticks[NUM_PARTICLES];
+    u16             ticks_max[NUM_PARTICLES];
+    u8              dead[NUM_PARTICLES];
+    u8              bounced[NUM_PARTICLES]; // bit 0: on x, bit 1: on y
+    particle_s      particles[NUM_PARTICLES];
     particle_emit_s emitters[16];
 } particle_sys_s;
 
+static_assert((NUM_PARTICLES % PARTICLE_BLOCK_SIZE) == 0, "particle blocks");
+
 particle_emit_s *particle_emitter_create(g_s *g);
 void             particle_emitter_destroy(g_s             *g,
                                           particle_emit_s *pe);
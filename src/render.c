@@ -7,15 +7,7 @@
 #include "game.h"
 
 void draw_gameplay(g_s *g);
-void draw_light_circle(gfx_ctx_s ctx, v2_i32 p, i32 radius, i32 strength);
-i32  objs_draw(gfx_ctx_s ctx, g_s *g, v2_i32 cam, i32 ifrom, i32 prio);
-
-static inline i32 cmp_obj_render_priority(obj_s **a, obj_s **b)
-{
-    return (i32)(*a)->render_priority - (i32)(*b)->render_priority;
-}
-
-SORT_ARRAY_DEF(obj_s *, obj_render, cmp_obj_render_priority)
+i32  objs_draw(gfx_ctx_s ctx, g_s *g, v2_i32 cam, i32 pfrom, i32 prio);
 
 static v2_i32 fg_parallax(v2_i32 cam, i32 x_q8, i32 y_q8, i32 ax, i32 ay)
 {
@@ -63,7 +55,10 @@ void draw_gameplay(g_s *g)
     gfx_ctx_s         ctx               = gfx_ctx_from_tex(texdisplay);
     tile_map_bounds_s tilebounds        = tile_map_bounds_rec(g, camrec);
     tex_s             tex_outline_layer = asset_tex(TEXID_DISPLAY_WHITE_OUTLINED);
-    tex_clr(tex_outline_layer, GFX_COL_CLEAR);
+
+    // only clear what was drawn into the outline layer last frame
+    tex_clr_rec(tex_outline_layer, tex_dirty_rec(tex_outline_layer), GFX_COL_CLEAR);
+    tex_dirty_reset(tex_outline_layer);
 
     background_draw(g, camoffset_raw, camoff);
 
@@ -75,10 +70,7 @@ void draw_gameplay(g_s *g)
     }
     particle_sys_draw(g, camoff);
 
-    if (g->objrender_dirty) {
-        g->objrender_dirty = 0;
-        sort_obj_render(g->obj_render, g->n_objrender);
-    }
+    objs_render_flush(g);
 
     i_obj = objs_draw(ctx, g, camoff, i_obj, RENDER_PRIO_BACKGROUND);
 
@@ -114,7 +106,8 @@ void draw_gameplay(g_s *g)
 
     i_obj = objs_draw(ctx, g, camoff, i_obj, RENDER_PRIO_INFRONT_TERRAIN_LAYER);
     boss_draw(g, camoff);
-    tex_merge_to_opaque_outlined_white(texdisplay, tex_outline_layer);
+    tex_merge_to_opaque_outlined_white_rec(texdisplay, tex_outline_layer,
+                                           tex_dirty_rec(tex_outline_layer));
     render_terrain(g, tilebounds, camoff);
 
     i32     parallaxox = ((cam_mid.x - (g->pixel_x >> 1)) * 410) >> 12;
@@ -130,27 +123,7 @@ void draw_gameplay(g_s *g)
 
     i_obj = objs_draw(ctx, g, camoff, i_obj, RENDER_PRIO_UI_LEVEL);
     if (g->dark) {
-        spm_push();
-
-        tex_s tlight = tex_create(PLTF_DISPLAY_W, PLTF_DISPLAY_H, 0, spm_allocator(), 0);
-        tex_clr(tlight, GFX_COL_BLACK);
-        gfx_ctx_s lctx = gfx_ctx_from_tex(tlight);
-
-        for (obj_each(g, it)) {
-            if (!(it->flags & OBJ_FLAG_LIGHT)) continue;
-
-            i32    r = it->light_radius;
-            v2_i32 p = v2_i32_add(obj_pos_center(it), camoff);
-            draw_light_circle(lctx, p, r, it->light_strength);
-        }
-
-        u32 *p1 = ctx.dst.px;
-        u32 *p2 = tlight.px;
-        for (i32 n = 0; n < PLTF_DISPLAY_NUM_WORDS; n++) {
-            *p1++ &= *p2++;
-        }
-
-        spm_pop();
+        lighting_draw(g, ctx.dst, camoff);
     }
 
     switch (g->vfx_ID) {
@@ -185,55 +158,70 @@ void draw_gameplay(g_s *g)
     render_hero_ui(g, ohero, camoff);
 }
 
-i32 objs_draw(gfx_ctx_s ctx, g_s *g, v2_i32 cam, i32 ifrom, i32 prio)
+static void objs_draw_obj(gfx_ctx_s ctx, g_s *g, owl_s *h, obj_s *o, v2_i32 cam)
 {
-    owl_s *h = &g->owl;
-    i32    i = ifrom;
-
-    for (; i < g->n_objrender; i++) {
-        obj_s *o = g->obj_render[i];
-        if (prio <= o->render_priority) break;
-        if (o->flags & OBJ_FLAG_DONT_SHOW) continue;
-        if (o->blinking && ((g->tick_gameplay >> 1) & 1)) continue;
-
-        v2_i32 ppos = v2_i32_add(o->pos, cam);
-        if (o->ID == OBJID_OWL) {
-            if (g->cam.cowl.do_align_x) {
-                ppos.x &= ~1;
-            }
-            if (g->cam.cowl.do_align_y) {
-                ppos.y &= ~1;
-            }
-        }
+    if (o->flags & OBJ_FLAG_DONT_SHOW) return;
+    if (o->blinking && ((g->tick_gameplay >> 1) & 1)) return;
 
-        if (o->enemy.hurt_tick) {
-            ppos.x += rngr_sym_i32(3);
-            ppos.y += rngr_sym_i32(3);
+    v2_i32 ppos = v2_i32_add(o->pos, cam);
+    if (o->ID == OBJID_OWL) {
+        if (g->cam.cowl.do_align_x) {
+            ppos.x &= ~1;
+        }
+        if (g->cam.cowl.do_align_y) {
+            ppos.y &= ~1;
         }
+    }
+
+    if (o->enemy.hurt_tick) {
+        ppos.x += rngr_sym_i32(3);
+        ppos.y += rngr_sym_i32(3);
+    }
 
-        for (i32 n = 0; n < o->n_sprites; n++) {
-            obj_sprite_s sprite = o->sprites[n];
-            if (!sprite.trec.t.px) continue;
+    for (i32 n = 0; n < o->n_sprites; n++) {
+        obj_sprite_s sprite = o->sprites[n];
+        if (!sprite.trec.t.px) continue;
 
-            v2_i32 sprpos = v2_i32_add(ppos, v2_i32_from_i16(sprite.offs));
-            gfx_spr(ctx, sprite.trec, sprpos, sprite.flip, o->enemy.flash_tick ? SPR_MODE_WHITE : 0);
+        v2_i32 sprpos = v2_i32_add(ppos, v2_i32_from_i16(sprite.offs));
+        gfx_spr(ctx, sprite.trec, sprpos, sprite.flip, o->enemy.flash_tick ? SPR_MODE_WHITE : 0);
 
-            if (o->ID == OBJID_OWL && h->stamina_blink_tick) {
-                gfx_ctx_s ctx2 = ctx;
+        if (o->ID == OBJID_OWL && h->stamina_blink_tick) {
+            gfx_ctx_s ctx2 = ctx;
 
-                i32 k1   = lerp_i32(0, 65536, h->stamina_blink_tick, h->stamina_blink_tick_max);
-                i32 num  = (256 * (sin_q15(k1))) >> 15;
-                // num      = (160 * ((num * num))) >> 16;
-                num      = (192 * ((num))) >> 8;
-                ctx2.pat = gfx_pattern_interpolate(num, 256);
-                gfx_spr(ctx2, sprite.trec, sprpos, sprite.flip, SPR_MODE_BLACK);
-            }
+            i32 k1   = lerp_i32(0, 65536, h->stamina_blink_tick, h->stamina_blink_tick_max);
+            i32 num  = (256 * (sin_q15(k1))) >> 15;
+            // num      = (160 * ((num * num))) >> 16;
+            num      = (192 * ((num))) >> 8;
+            ctx2.pat = gfx_pattern_interpolate(num, 256);
+            gfx_spr(ctx2, sprite.trec, sprpos, sprite.flip, SPR_MODE_BLACK);
+        }
+    }
+    if (o->on_draw) {
+        o->on_draw(g, o, cam);
+    }
+}
+
+// draws all render buckets in [pfrom, prio), returns the next bucket to draw
+i32 objs_draw(gfx_ctx_s ctx, g_s *g, v2_i32 cam, i32 pfrom, i32 prio)
+{
+    owl_s *h  = &g->owl;
+    i32    p2 = min_i32(prio, OBJ_RENDER_PENDING);
+
+    for (i32 p = pfrom; p < p2; p++) {
+        u32 used = g->obj_render_used[p >> 5] >> (p & 31);
+        if (!used) { // skip to the next word of the bitset
+            p |= 31;
+            continue;
         }
-        if (o->on_draw) {
-            o->on_draw(g, o, cam);
+        if (!(used & 1)) continue;
+
+        for (obj_s *o = g->obj_render[p], *onext; o; o = onext) {
+            assert(o->render_priority == p); // use obj_render_priority_set
+            onext = o->render_next;
+            objs_draw_obj(ctx, g, h, o, cam);
         }
     }
-    return i;
+    return max_i32(pfrom, p2);
 }
 
 void render_tilemap(g_s *g, i32 layer, tile_map_bounds_s bounds, v2_i32 cam)
@@ -610,38 +598,6 @@ v2_i32 parallax_offs(v2_i32 cam, v2_i32 pos, i32 x_q8, i32 y_q8)
     return p;
 }
 
-void draw_light_circle(gfx_ctx_s ctx, v2_i32 p, i32 radius, i32 strength)
-{
-    i32       str  = min_i32(strength + 1, 4);
-    u32       seed = pltf_cur_tick() >> 1;
-    i32       r    = radius;
-    i32       y1   = max_i32(p.y - r, ctx.clip_y1);
-    i32       y2   = min_i32(p.y + r, ctx.clip_y2);
-    gfx_ctx_s ctxw = ctx;
-
-    gfx_pattern_s pts[4] = {
-        gfx_pattern_2x2(B2(00), B2(10)),
-        gfx_pattern_2x2(B2(01), B2(10)),
-        gfx_pattern_2x2(B2(11), B2(10)),
-        gfx_pattern_2x2(B2(11), B2(11))};
-    i32 r2[4] = {
-        pow2_i32((256 * r) >> 8),
-        pow2_i32((220 * r) >> 8),
-        pow2_i32((190 * r) >> 8),
-        pow2_i32((150 * r) >> 8)};
-
-    for (i32 y = y1; y <= y2; y++) {
-        i32 px  = p.x + rngsr_i32(&seed, -1, +1);
-        i32 dy2 = pow2_i32(p.y - y);
-        for (i32 i = 0; i < str; i++) {
-            i32 dx   = sqrt_u32(max_i32(r2[i] - dy2, 0));
-            i32 x1   = px - dx;
-            ctxw.pat = pts[i];
-            gfx_rec_strip(ctxw, x1, y, dx << 1, GFX_COL_WHITE);
-        }
-    }
-}
-
 void render_map_transition_in(g_s *g, v2_i32 cam, i32 t, i32 t2)
 {
     tex_s     display = asset_tex(0);
@@ -5,28 +5,54 @@
 #include "tile_map.h"
 #include "game.h"
 
-bool32 tile_solid_pt(i32 shape, i32 x, i32 y)
+// solid pixels of each tile shape: one row per y, bit x set if solid
+#define TILE_ROWS(F)                                 \
+    {F(0), F(1), F(2), F(3), F(4), F(5), F(6), F(7), \
+     F(8), F(9), F(10), F(11), F(12), F(13), F(14), F(15)}
+#define TILE_ROW_EMPTY(Y)    0
+#define TILE_ROW_BLOCK(Y)    0xFFFF
+#define TILE_ROW_45_0(Y)     (0xFFFF & (0xFFFF << (15 - (Y)))) // x >= 15 - y
+#define TILE_ROW_45_1(Y)     (0xFFFF & (0xFFFF << (Y)))        // x >= y
+#define TILE_ROW_45_2(Y)     (0xFFFF >> (15 - (Y)))            // x <= y
+#define TILE_ROW_45_3(Y)     (0xFFFF >> (Y))                   // x <= 15 - y
+#define TILE_SPAN(X0, X1)    ((0xFFFF & (0xFFFF << (X0))) & (0xFFFF >> (15 - (X1))))
+#define TILE_HAS_ROWS(SHAPE) ((u32)(SHAPE) < NUM_TILE_SHAPES)
+
+const u16 g_tile_rows[NUM_TILE_SHAPES][16] = {
+    TILE_ROWS(TILE_ROW_EMPTY),
+    TILE_ROWS(TILE_ROW_BLOCK),
+    TILE_ROWS(TILE_ROW_45_0),
+    TILE_ROWS(TILE_ROW_45_1),
+    TILE_ROWS(TILE_ROW_45_2),
+    TILE_ROWS(TILE_ROW_45_3)};
+
+// [shape][y0][y1]: rows y0..y1 merged into one row
+// -> a rectangle query is a single AND with the span mask
+static u16 g_tile_rows_or[NUM_TILE_SHAPES][16][16];
+
+void tile_masks_init()
 {
-    switch (shape) {
-    case TILE_BLOCK: return 1;
-    case TILE_SLOPE_45_0: return ((15 - x) <= y);
-    case TILE_SLOPE_45_3: return ((15 - x) >= y);
-    case TILE_SLOPE_45_1: return (x >= y);
-    case TILE_SLOPE_45_2: return (x <= y);
+    for (i32 s = 0; s < NUM_TILE_SHAPES; s++) {
+        for (i32 y0 = 0; y0 < 16; y0++) {
+            u32 m = 0;
+            for (i32 y1 = y0; y1 < 16; y1++) {
+                m |= g_tile_rows[s][y1];
+                g_tile_rows_or[s][y0][y1] = (u16)m;
+            }
+        }
     }
-    return 0;
+}
+
+bool32 tile_solid_pt(i32 shape, i32 x, i32 y)
+{
+    if (!TILE_HAS_ROWS(shape)) return 0;
+    return ((g_tile_rows[shape][y] >> x) & 1);
 }
 
 bool32 tile_solid_r(i32 shape, i32 x0, i32 y0, i32 x1, i32 y1)
 {
-    switch (shape) {
-    case TILE_BLOCK: return 1;
-    case TILE_SLOPE_45_0: return ((15 - x1) <= y1);
-    case TILE_SLOPE_45_3: return ((15 - x0) >= y0);
-    case TILE_SLOPE_45_1: return (x1 >= y0);
-    case TILE_SLOPE_45_2: return (x0 <= y1);
-    }
-    return 0;
+    if (!TILE_HAS_ROWS(shape)) return 0;
+    return (g_tile_rows_or[shape][y0][y1] & TILE_SPAN(x0, x1));
 }
 
 // triangle coordinates
@@ -116,13 +142,16 @@ bool32 tile_map_solid(g_s *g, rec_i32 r)
         i32 y1 = (ty == ty1 ? py1 & 15 : 15);
         i32 tv = clamp_i32(ty, 0, g->tiles_y - 1);
 
+        const tile_s *trow = &g->tiles[tv * g->tiles_x];
         for (i32 tx = tx0; tx <= tx1; tx++) {
-            i32    tu   = clamp_i32(tx, 0, g->tiles_x - 1);
-            tile_s tile = g->tiles[tu + tv * g->tiles_x];
-            i32    ID   = tile.shape;
-            i32    x0   = (tx == tx0 ? px0 & 15 : 0);
-            i32    x1   = (tx == tx1 ? px1 & 15 : 15);
-            if (tile_solid_r(ID, x0, y0, x1, y1)) {
+            i32 tu    = clamp_i32(tx, 0, g->tiles_x - 1);
+            i32 shape = trow[tu].shape;
+            if (!TILE_HAS_ROWS(shape)) continue;
+
+            i32 x0 = (tx == tx0 ? px0 & 15 : 0);
+            i32 x1 = (tx == tx1 ? px1 & 15 : 15);
+            u32 m  = g_tile_rows_or[shape][y0][y1];
+            if (m & TILE_SPAN(x0, x1)) {
                 return 1;
             }
         }
@@ -159,6 +188,8 @@ void tile_map_set_collision(g_s *g, rec_i32 r, i32 shape, i32 type)
         }
     }
 
+    tile_map_corners_dirty(g, tx, ty, tx + nx - 1, ty + ny - 1);
+    tile_map_solid_bits_update(g, tx, ty, tx + nx - 1, ty + ny - 1);
     if (TILE_IS_SHAPE(shape)) {
         game_on_solid_appear(g);
     }
@@ -227,6 +258,388 @@ i32 map_climbable_pt(g_s *g, i32 x, i32 y)
     return MAP_CLIMBABLE_NO_TERRAIN;
 }
 
+// Raycasting works on pixel centers in doubled coordinates (pixel x -> 2x + 1,
+// pixel size 2, tile size 32) so every cell border is an integer.
+// Ray parameters t are kept as fractions n/d with d > 0.
+typedef struct {
+    i64 n;
+    i64 d;
+} ray_t_s;
+
+// DDA over a grid of cells
+typedef struct {
+    ray_t_s t_x;  // t of the next cell border on each axis,
+    ray_t_s t_y;  // "infinite" if not moving along it
+    i32     size; // cell size in doubled coordinates
+    i32     sx;
+    i32     sy;
+    i32     cx; // current cell
+    i32     cy;
+} ray_grid_s;
+
+static inline bool32 ray_t_lt(ray_t_s a, ray_t_s b)
+{
+    return (a.n * b.d < b.n * a.d);
+}
+
+static inline i32 ray_floor_div(i64 a, i64 b)
+{
+    i64 q = a / b;
+    return (i32)(q - ((a % b) != 0 && (a < 0)));
+}
+
+// pixel on the ray at t; on a pixel border the one the ray moves into
+static v2_i32 ray_px(v2_i32 a, v2_i32 d, ray_t_s t)
+{
+    i64    x = (i64)a.x * t.d + (i64)d.x * t.n;
+    i64    y = (i64)a.y * t.d + (i64)d.y * t.n;
+    i64    m = t.d << 1;
+    v2_i32 p = {d.x < 0 ? -ray_floor_div(-x, m) - 1 : ray_floor_div(x, m),
+                d.y < 0 ? -ray_floor_div(-y, m) - 1 : ray_floor_div(y, m)};
+    return p;
+}
+
+static void ray_grid_init(ray_grid_s *r, v2_i32 a, v2_i32 d, i32 cx, i32 cy, i32 size)
+{
+    r->t_x  = (ray_t_s){2, 1};
+    r->t_y  = (ray_t_s){2, 1};
+    r->size = size;
+    r->sx   = sgn_i32(d.x);
+    r->sy   = sgn_i32(d.y);
+    r->cx   = cx;
+    r->cy   = cy;
+    if (r->sx) {
+        r->t_x.n = 0 < r->sx ? (cx + 1) * size - a.x : a.x - cx * size;
+        r->t_x.d = abs_i32(d.x);
+    }
+    if (r->sy) {
+        r->t_y.n = 0 < r->sy ? (cy + 1) * size - a.y : a.y - cy * size;
+        r->t_y.d = abs_i32(d.y);
+    }
+}
+
+static inline ray_t_s ray_grid_t_next(ray_grid_s *r)
+{
+    return (ray_t_lt(r->t_x, r->t_y) ? r->t_x : r->t_y);
+}
+
+// moves into the next cell and returns the normal of the border crossed
+// passing exactly through a corner steps diagonally:
+// touching the two side cells in a single point is no hit
+static v2_i32 ray_grid_step(ray_grid_s *r, ray_t_s *t)
+{
+    bool32 step_x = !ray_t_lt(r->t_y, r->t_x);
+    bool32 step_y = !ray_t_lt(r->t_x, r->t_y);
+    v2_i32 n      = {0};
+    *t            = step_x ? r->t_x : r->t_y;
+    if (step_x) {
+        r->cx += r->sx;
+        r->t_x.n += r->size;
+        n.x = -r->sx;
+    }
+    if (step_y) {
+        r->cy += r->sy;
+        r->t_y.n += r->size;
+        n.y = -r->sy;
+    }
+    return n;
+}
+
+// walks the pixels of tile tx/ty crossed by the ray in [t, t_out) and
+// tests them against the tile masks, same as tile_map_solid_pt
+static bool32 tile_ray_px(i32 shape, v2_i32 a, v2_i32 d, i32 tx, i32 ty,
+                          ray_t_s t, ray_t_s t_out, v2_i32 n,
+                          tile_map_ray_hit_s *hit)
+{
+    v2_i32     p = ray_px(a, d, t);
+    ray_grid_s r;
+    ray_grid_init(&r, a, d,
+                  clamp_i32(p.x, tx << 4, (tx << 4) + 15),
+                  clamp_i32(p.y, ty << 4, (ty << 4) + 15), 2);
+
+    while (1) {
+        if (tile_solid_pt(shape, r.cx & 15, r.cy & 15)) {
+            hit->p.x = r.cx;
+            hit->p.y = r.cy;
+            hit->n   = t.n == 0 ? (v2_i32){0} : n;
+            hit->tx  = tx;
+            hit->ty  = ty;
+            hit->o   = 0;
+            hit->t_n = t.n;
+            hit->t_d = t.d;
+            return 1;
+        }
+        if (!ray_t_lt(ray_grid_t_next(&r), t_out)) break;
+        n = ray_grid_step(&r, &t);
+    }
+    return 0;
+}
+
+bool32 tile_map_raycast(g_s *g, v2_i32 p0, v2_i32 p1, tile_map_ray_hit_s *hit)
+{
+    v2_i32     a     = {(p0.x << 1) + 1, (p0.y << 1) + 1};
+    v2_i32     d     = {(p1.x - p0.x) << 1, (p1.y - p0.y) << 1};
+    ray_t_s    t_one = {1, 1};
+    ray_t_s    t_in  = {0, 1};
+    v2_i32     n_in  = {0};
+    ray_grid_s r;
+    ray_grid_init(&r, a, d, p0.x >> 4, p0.y >> 4, 32);
+
+    while (1) {
+        ray_t_s t_out = ray_grid_t_next(&r);
+        if (ray_t_lt(t_one, t_out)) {
+            t_out = t_one;
+        }
+
+        // outer edge tiles are projected into infinity for
+        // tile positions out of the level
+        i32 tu    = clamp_i32(r.cx, 0, g->tiles_x - 1);
+        i32 tv    = clamp_i32(r.cy, 0, g->tiles_y - 1);
+        i32 shape = g->tiles[tu + tv * g->tiles_x].shape;
+        if (TILE_IS_SHAPE(shape) &&
+            tile_ray_px(shape, a, d, r.cx, r.cy, t_in, t_out, n_in, hit)) {
+            return 1;
+        }
+        if (!ray_t_lt(t_out, t_one)) break;
+        n_in = ray_grid_step(&r, &t_in);
+    }
+    return 0;
+}
+
+// slab test of the ray against the pixels of r
+static bool32 ray_rec(v2_i32 a, v2_i32 d, rec_i32 r, ray_t_s *t, v2_i32 *n)
+{
+    ray_t_s t_in  = {0, 1};
+    ray_t_s t_out = {1, 1};
+    v2_i32  n_in  = {0};
+    i32     lo[2] = {r.x << 1, r.y << 1};
+    i32     hi[2] = {(r.x + r.w) << 1, (r.y + r.h) << 1};
+    i32     ai[2] = {a.x, a.y};
+    i32     di[2] = {d.x, d.y};
+
+    for (i32 k = 0; k < 2; k++) {
+        if (di[k] == 0) {
+            if (ai[k] < lo[k] || hi[k] < ai[k]) return 0;
+            continue;
+        }
+        i32     s  = sgn_i32(di[k]);
+        ray_t_s t1 = {0 < s ? lo[k] - ai[k] : ai[k] - hi[k], abs_i32(di[k])};
+        ray_t_s t2 = {0 < s ? hi[k] - ai[k] : ai[k] - lo[k], abs_i32(di[k])};
+        if (ray_t_lt(t_in, t1)) {
+            t_in    = t1;
+            n_in    = (v2_i32){0};
+            k == 0 ? (n_in.x = -s) : (n_in.y = -s);
+        }
+        if (ray_t_lt(t2, t_out)) {
+            t_out = t2;
+        }
+    }
+    if (!ray_t_lt(t_in, t_out)) return 0; // touching a corner only
+    *t = t_in;
+    *n = n_in;
+    return 1;
+}
+
+bool32 map_raycast(g_s *g, v2_i32 p0, v2_i32 p1, obj_s *o, tile_map_ray_hit_s *hit)
+{
+    bool32  res = tile_map_raycast(g, p0, p1, hit);
+    ray_t_s t_h = {2, 1};
+    if (res) {
+        t_h.n = hit->t_n;
+        t_h.d = hit->t_d;
+    }
+    hit->o = 0;
+
+    v2_i32 a = {(p0.x << 1) + 1, (p0.y << 1) + 1};
+    v2_i32 d = {(p1.x - p0.x) << 1, (p1.y - p0.y) << 1};
+    for (obj_each(g, i)) {
+        if (i == o || !(i->flags & OBJ_FLAG_SOLID)) continue;
+
+        rec_i32 r = obj_aabb(i);
+        ray_t_s t;
+        v2_i32  n;
+        if (!ray_rec(a, d, r, &t, &n) || !ray_t_lt(t, t_h)) continue;
+
+        v2_i32 p = ray_px(a, d, t);
+        t_h      = t;
+        hit->p.x = clamp_i32(p.x, r.x, r.x + r.w - 1);
+        hit->p.y = clamp_i32(p.y, r.y, r.y + r.h - 1);
+        hit->n   = t.n == 0 ? (v2_i32){0} : n;
+        hit->tx  = hit->p.x >> 4;
+        hit->ty  = hit->p.y >> 4;
+        hit->t_n = t.n;
+        hit->t_d = t.d;
+        hit->o   = i;
+        res      = 1;
+    }
+    return res;
+}
+
+// directions around a vertex, clockwise (y down): octant k spans k..k+1
+static const v2_i32 g_corner_dir[8] = {{+1, +0}, {+1, +1}, {+0, +1}, {-1, +1},
+                                       {-1, +0}, {-1, -1}, {+0, -1}, {+1, -1}};
+
+// bit k set if octant k around the vertex is solid
+static u32 tile_map_corner_octants(g_s *g, i32 vx, i32 vy)
+{
+    u32 occ = 0;
+    for (i32 k = 0; k < 8; k++) {
+        // sample point inside octant k in 4x scaled tile coordinates
+        v2_i32 d = v2_i32_add(g_corner_dir[k], g_corner_dir[(k + 1) & 7]);
+        i32    x = (vx << 6) + d.x;
+        i32    y = (vy << 6) + d.y;
+        i32    tx = x >> 6;
+        i32    ty = y >> 6;
+        i32    lx = x & 63;
+        i32    ly = y & 63;
+        tile_s t  = tile_map_get_at(g, tx, ty);
+
+        bool32 solid = 0;
+        switch (t.shape) {
+        case TILE_BLOCK: solid = 1; break;
+        case TILE_SLOPE_45_0: solid = (64 <= lx + ly); break;
+        case TILE_SLOPE_45_1: solid = (ly <= lx); break;
+        case TILE_SLOPE_45_2: solid = (lx <= ly); break;
+        case TILE_SLOPE_45_3: solid = (lx + ly <= 64); break;
+        }
+        occ |= (u32)solid << k;
+    }
+    return occ;
+}
+
+// a corner is convex if a run of solid octants spans less than 180 deg
+static i32 tile_map_corner_runs(u32 occ, i32 *run_s, i32 *run_l)
+{
+    if (occ == 0 || occ == 0xFF) return 0;
+
+    i32 k0 = 0; // start scanning at an empty octant
+    while (occ & (1u << k0)) {
+        k0++;
+    }
+
+    i32 n = 0;
+    for (i32 i = 1; i <= 8; i++) {
+        i32 k = (k0 + i) & 7;
+        if (!(occ & (1u << k))) continue;
+        if (occ & (1u << ((k + 7) & 7))) continue; // not the start of a run
+
+        i32 l = 1;
+        while (occ & (1u << ((k + l) & 7))) {
+            l++;
+        }
+        if (l <= 3) {
+            run_s[n] = k;
+            run_l[n] = l;
+            n++;
+        }
+    }
+    return n;
+}
+
+void tile_map_solid_bits_init(g_s *g)
+{
+    tile_solid_bits_s *b = &g->solid_bits;
+    mclr(b, sizeof(tile_solid_bits_s));
+    if (TILE_SOLID_BITS_MAX_TILES < g->tiles_x * g->tiles_y) return;
+
+    b->tiles_x = g->tiles_x;
+    b->tiles_y = g->tiles_y;
+    b->rows    = game_alloc_roomtn(g, u16, (g->tiles_x * g->tiles_y) << 4);
+}
+
+void tile_map_solid_bits_update(g_s *g, i32 tx1, i32 ty1, i32 tx2, i32 ty2)
+{
+    tile_solid_bits_s *b = &g->solid_bits;
+    if (!b->rows) return;
+
+    i32 x1 = max_i32(tx1, 0);
+    i32 y1 = max_i32(ty1, 0);
+    i32 x2 = min_i32(tx2, b->tiles_x - 1);
+    i32 y2 = min_i32(ty2, b->tiles_y - 1);
+    for (i32 ty = y1; ty <= y2; ty++) {
+        for (i32 tx = x1; tx <= x2; tx++) {
+            i32  shape = g->tiles[tx + ty * g->tiles_x].shape;
+            u16 *r     = &b->rows[tx + (ty << 4) * b->tiles_x];
+
+            for (i32 y = 0; y < 16; y++, r += b->tiles_x) {
+                *r = TILE_HAS_ROWS(shape) ? g_tile_rows[shape][y] : 0;
+            }
+        }
+    }
+}
+
+void tile_map_corners_init(g_s *g)
+{
+    tile_corners_s *tc = &g->corners;
+    tc->n_x            = (g->tiles_x >> TILE_CORNERS_CHUNK_SHIFT) + 1;
+    tc->n_y            = (g->tiles_y >> TILE_CORNERS_CHUNK_SHIFT) + 1;
+    i32 n_chunks       = tc->n_x * tc->n_y;
+    tc->mask           = game_alloc_roomtn(g, u64, n_chunks);
+    tc->dirty          = game_alloc_roomtn(g, u32, (n_chunks + 31) >> 5);
+    mset(tc->dirty, 0xFF, sizeof(u32) * ((n_chunks + 31) >> 5));
+}
+
+void tile_map_corners_dirty(g_s *g, i32 tx1, i32 ty1, i32 tx2, i32 ty2)
+{
+    tile_corners_s *tc = &g->corners;
+    if (!tc->dirty) return;
+
+    // a tile affects the four vertices of its corners
+    i32 cx1 = max_i32(tx1, 0) >> TILE_CORNERS_CHUNK_SHIFT;
+    i32 cy1 = max_i32(ty1, 0) >> TILE_CORNERS_CHUNK_SHIFT;
+    i32 cx2 = min_i32((tx2 + 1) >> TILE_CORNERS_CHUNK_SHIFT, tc->n_x - 1);
+    i32 cy2 = min_i32((ty2 + 1) >> TILE_CORNERS_CHUNK_SHIFT, tc->n_y - 1);
+    for (i32 cy = cy1; cy <= cy2; cy++) {
+        for (i32 cx = cx1; cx <= cx2; cx++) {
+            i32 c = cx + cy * tc->n_x;
+            tc->dirty[c >> 5] |= (u32)1 << (c & 31);
+        }
+    }
+}
+
+u64 tile_map_corners_chunk(g_s *g, i32 cx, i32 cy)
+{
+    tile_corners_s *tc = &g->corners;
+    i32             c  = cx + cy * tc->n_x;
+    if (!(tc->dirty[c >> 5] & ((u32)1 << (c & 31)))) {
+        return tc->mask[c];
+    }
+
+    tc->dirty[c >> 5] &= ~((u32)1 << (c & 31));
+    u64 m  = 0;
+    i32 vx = cx << TILE_CORNERS_CHUNK_SHIFT;
+    i32 vy = cy << TILE_CORNERS_CHUNK_SHIFT;
+    for (i32 y = 0; y < 8; y++) {
+        for (i32 x = 0; x < 8; x++) {
+            if (g->tiles_x < vx + x || g->tiles_y < vy + y) continue;
+
+            i32 run_s[4], run_l[4];
+            u32 occ = tile_map_corner_octants(g, vx + x, vy + y);
+            if (tile_map_corner_runs(occ, run_s, run_l)) {
+                m |= (u64)1 << (x + y * 8);
+            }
+        }
+    }
+    tc->mask[c] = m;
+    return m;
+}
+
+i32 tile_map_corners_at(g_s *g, i32 vx, i32 vy, tile_corner_s *c)
+{
+    i32 run_s[4], run_l[4];
+    u32 occ = tile_map_corner_octants(g, vx, vy);
+    i32 n   = tile_map_corner_runs(occ, run_s, run_l);
+    for (i32 i = 0; i < n; i++) {
+        v2_i32 du = v2_i32_shl(g_corner_dir[run_s[i]], 4);
+        v2_i32 dv = v2_i32_shl(g_corner_dir[(run_s[i] + run_l[i]) & 7], 4);
+        c[i].p.x  = vx << 4;
+        c[i].p.y  = vy << 4;
+        c[i].u    = v2_i32_add(c[i].p, du);
+        c[i].v    = v2_i32_add(c[i].p, dv);
+    }
+    return n;
+}
+
 tile_map_bounds_s tile_map_bounds_rec(g_s *g, rec_i32 r)
 {
     v2_i32 pmin = {r.x, r.y};
@@ -45,6 +45,7 @@ typedef struct {
     tri_i32 t[2];
 } tile_tris_s;
 
+void    tile_masks_init();
 bool32  tile_solid_pt(i32 shape, i32 x, i32 y);
 bool32  tile_solid_r(i32 shape, i32 x0, i32 y0, i32 x1, i32 y1);
 //
@@ -60,6 +61,24 @@ bool32  map_blocked_excl_offs(g_s *g, rec_i32 r, obj_s *o, i32 dx, i32 dy);
 bool32  map_blocked_offs(g_s *g, rec_i32 r, i32 dx, i32 dy);
 bool32  map_blocked_pt(g_s *g, i32 x, i32 y);
 
+typedef struct {
+    v2_i32 p;   // first solid pixel along the ray
+    v2_i32 n;   // pixel border crossed into p, components -1/0/+1;
+                // zero if starting inside
+    i32    tx;  // tile of the hit
+    i32    ty;
+    obj_s *o;   // solid object hit (map_raycast only)
+    i64    t_n; // position along the ray: t_n / t_d in [0, 1]
+    i64    t_d;
+} tile_map_ray_hit_s;
+
+// walks the tiles crossed by the segment p0 -> p1 and, inside
+// collision tiles, the pixels crossed; hit->p is solid
+// for tile_map_solid_pt
+bool32 tile_map_raycast(g_s *g, v2_i32 p0, v2_i32 p1, tile_map_ray_hit_s *hit);
+// like tile_map_raycast but also against solid objects except o
+bool32 map_raycast(g_s *g, v2_i32 p0, v2_i32 p1, obj_s *o, tile_map_ray_hit_s *hit);
+
 enum {
     MAP_CLIMBABLE_NO_TERRAIN,
     MAP_CLIMBABLE_SUCCESS,
@@ -68,6 +87,57 @@ enum {
 
 i32 map_climbable_pt(g_s *g, i32 x, i32 y);
 
+// convex terrain corners on the tile vertex grid, bucketed into chunks
+// of 8x8 vertices and rebuilt lazily after tiles changed
+#define TILE_CORNERS_CHUNK_SHIFT 3
+
+typedef struct {
+    i32  n_x;   // chunks per row
+    i32  n_y;   // chunk rows
+    u64 *mask;  // per chunk: bit (x + y * 8) set if vertex has a convex corner
+    u32 *dirty; // bitset: chunk mask needs a rebuild
+} tile_corners_s;
+
+typedef struct {
+    v2_i32 p; // corner vertex
+    v2_i32 u; // along the solid's edges
+    v2_i32 v;
+} tile_corner_s;
+
+void tile_map_corners_init(g_s *g);
+// tiles in [tx1, tx2] x [ty1, ty2] changed
+void tile_map_corners_dirty(g_s *g, i32 tx1, i32 ty1, i32 tx2, i32 ty2);
+// vertex mask of a chunk, rebuilt if dirty
+u64  tile_map_corners_chunk(g_s *g, i32 cx, i32 cy);
+// convex corners at a vertex, returns count (max 4)
+i32  tile_map_corners_at(g_s *g, i32 vx, i32 vy, tile_corner_s *c);
+
+// terrain solidity at pixel resolution: one u16 per tile row, laid out
+// row major so a point query is a single load and bit test;
+// only allocated for rooms up to TILE_SOLID_BITS_MAX_TILES
+#define TILE_SOLID_BITS_MAX_TILES 16384
+
+typedef struct {
+    u16 *rows;    // bit x of (tile x, pixel row y): rows[tx + y * tiles_x]
+    i32  tiles_x;
+    i32  tiles_y;
+} tile_solid_bits_s;
+
+// allocates the room's bitmap, filled once all tiles are placed
+void tile_map_solid_bits_init(g_s *g);
+// tiles in [tx1, tx2] x [ty1, ty2] changed
+void tile_map_solid_bits_update(g_s *g, i32 tx1, i32 ty1, i32 tx2, i32 ty2);
+
+// same as tile_map_solid_pt, requires b->rows
+static inline bool32 tile_solid_bits_pt(tile_solid_bits_s *b, i32 x, i32 y)
+{
+    // outer edge tiles are projected into infinity
+    i32 tx = clamp_i32(x >> 4, 0, b->tiles_x - 1);
+    i32 py = (clamp_i32(y >> 4, 0, b->tiles_y - 1) << 4) | (y & 15);
+    return ((b->rows[tx + py * b->tiles_x] >> (x & 15)) & 1);
+}
+
+extern const u16     g_tile_rows[NUM_TILE_SHAPES][16]; // bit x of row y set if solid
 extern const i32     g_tile_tris[NUM_TILE_SHAPES * 12];
 extern const tri_i16 g_tiletris[NUM_TILE_SHAPES];
 
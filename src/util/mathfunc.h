@@ -669,6 +669,25 @@ static u32 sqrt_u32(u32 x)
 
 #define sqrt_i32 sqrt_u32
 
+// approximation of 2^31 / sqrt(x) for x > 0 without divisions:
+// x is normalized to m in [1/4, 1), 1/sqrt(m) is seeded linearly
+// and refined by two newton steps; relative error < 2.2e-4
+static u32 rsqrt_appr_q31_u32(u32 x)
+{
+    assert(x);
+    i32 s = clz32(x) & ~1;
+    u32 m = x << s; // Q32
+    // r = 2.13 - 1.215 * m in Q30
+    u32 r = 2287070085U - (u32)(((u64)m * 1304596316U) >> 32);
+
+    for (i32 n = 0; n < 2; n++) {
+        u64 rr = ((u64)r * r) >> 30;
+        u64 mr = ((u64)m * rr) >> 32;
+        r      = (u32)(((u64)r * ((U64_C(3) << 30) - mr)) >> 31);
+    }
+    return (r >> (15 - (s >> 1)));
+}
+
 static u32 sqrt_u32_bitwise(u32 n)
 {
     u32 d = 1 << 30;
@@ -1907,6 +1926,35 @@ static bool32 overlap_rec_lineseg_excl(rec_i32 r, lineseg_i32 l)
     return !separated;
 }
 
+// checks if a rectangle is within distance cr of the segment ab
+static bool32 overlap_rec_capsule(rec_i32 r, v2_i32 a, v2_i32 b, i32 cr)
+{
+    // end points close to the rectangle
+    if (overlap_rec_cir(r, a.x, a.y, cr) || overlap_rec_cir(r, b.x, b.y, cr))
+        return 1;
+
+    lineseg_i32 l = {a, b};
+    if (overlap_rec_lineseg_excl(r, l))
+        return 1;
+
+    // corners close to the inner part of the segment
+    v2_i32 d  = v2_i32_sub(b, a);
+    i64    dd = v2_i32_lensql(d);
+    if (dd == 0) return 0;
+
+    v2_i32 p[4];
+    points_from_rec(r, p);
+    for (i32 n = 0; n < 4; n++) {
+        v2_i32 s = v2_i32_sub(p[n], a);
+        i64    t = (i64)s.x * d.x + (i64)s.y * d.y;
+        if (t <= 0 || dd <= t) continue; // closest to an end point
+
+        i64 c = v2_i32_crsl(d, s);
+        if (c * c <= (i64)cr * cr * dd) return 1;
+    }
+    return 0;
+}
+
 // paulbourke.net/geometry/circlesphere/
 static i32 intersect_cir(v2_i32 a, i32 ra, v2_i32 b, i32 rb,
                          v2_i32 *u, v2_i32 *v)
@@ -50,6 +50,27 @@ static inline u32 hash_str8(const void *str)
     return (hash_str(str) & 0xFF);
 }
 
+// compile time version of hash_str for string literals up to
+// HASH_STR_LIT_MAX chars: Horner's scheme ignores leading zeros, so the
+// literal is right aligned into a fixed number of steps
+#define HASH_STR_LIT_MAX 24
+#define HASH_STR_LIT(S)                                                          \
+    (HASH_STR_LIT_4(S, 20, HASH_STR_LIT_4(S, 16, HASH_STR_LIT_4(S, 12,           \
+     HASH_STR_LIT_4(S, 8, HASH_STR_LIT_4(S, 4, HASH_STR_LIT_4(S, 0, 0u)))))) + \
+     0u * (u32)sizeof(char[sizeof("" S "") <= HASH_STR_LIT_MAX + 1 ? 1 : -1]))
+#define HASH_STR_LIT_4(S, J, H)                                   \
+    ((((((H) * 101u + HASH_STR_LIT_C(S, J + 0)) * 101u +          \
+        HASH_STR_LIT_C(S, J + 1)) * 101u +                        \
+       HASH_STR_LIT_C(S, J + 2)) * 101u +                         \
+      HASH_STR_LIT_C(S, J + 3)))
+#define HASH_STR_LIT_C(S, J)                                             \
+    (HASH_STR_LIT_MAX + 1 <= (J) + sizeof(S)                             \
+         ? HASH_STR_LIT_LOWER((u32)(u8)(S)[(J) + sizeof(S) - 1 -         \
+                                           HASH_STR_LIT_MAX])            \
+         : 0u)
+#define HASH_STR_LIT_LOWER(C) ('A' <= (C) && (C) <= 'Z' ? (C) - 'A' + 'a' : (C))
+#define HASH_STR16_LIT(S)     (HASH_STR_LIT(S) & 0xFFFFu)
+
 #define FILEPATH_GEN(NAME, PATHNAME, FILENAME) \
     char NAME[128];                            \
     str_cpy(NAME, PATHNAME);                   \
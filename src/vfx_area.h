@@ -34,6 +34,7 @@ void vfx_area_snow_draw(g_s *g, v2_i32 cam);
 
 typedef struct vfx_area_heat_s {
     i32 tick;
+    i8  shift[PLTF_DISPLAY_H]; // per scanline x shift, refreshed every tick
 } vfx_area_heat_s;
 
 void vfx_area_heat_setup(g_s *g);
@@ -3,59 +3,136 @@
 // =============================================================================
 
 #include "game.h"
+#include "vfx_area.h"
+
+static_assert((PLTF_DISPLAY_W & 7) == 0, "heat rows end on a byte");
+
+static void vfx_area_heat_shift_table(vfx_area_heat_s *fx)
+{
+    for (i32 y = 0; y < PLTF_DISPLAY_H; y++) {
+        i32 a        = (sin_q16(fx->tick + y * 3000) * 2) / 65536;
+        fx->shift[y] = (i8)(a & ~1);
+    }
+}
 
 void vfx_area_heat_setup(g_s *g)
 {
     g->vfx_area_mem     = game_alloc_roomt(g, vfx_area_heat_s);
     vfx_area_heat_s *fx = (vfx_area_heat_s *)g->vfx_area_mem;
+    mclr(fx, sizeof(vfx_area_heat_s));
+    vfx_area_heat_shift_table(fx);
 }
 
 void vfx_area_heat_update(g_s *g)
 {
     vfx_area_heat_s *fx = (vfx_area_heat_s *)g->vfx_area_mem;
     fx->tick += 1500 + 200;
+    vfx_area_heat_shift_table(fx);
+}
+
+// Pixels are stored MSB first within each byte, so a row is a plain
+// bit stream in byte order. Shifting it by s < 8 pixels only moves bits
+// between neighbouring bytes. On a little endian 64 bit lane byte k sits
+// in bits 8k..8k+7: masking per byte keeps the lane free of bswaps, and
+// the pixel repeated at the row edge becomes the carry byte.
+
+#define VFX_HEAT_BYTES_LO(S) ((U64_C(0xFFFFFFFFFFFFFFFF) / 0xFF) * (u64)(0xFF >> (S)))
+
+static inline u64 vfx_heat_lane_ld(u8 *p)
+{
+    u64 v;
+    mcpy(&v, p, sizeof(u64));
+    return v;
+}
+
+static inline void vfx_heat_lane_st(u8 *p, u64 v)
+{
+    mcpy(p, &v, sizeof(u64));
+}
+
+static inline u64 vfx_heat_half_ld(u8 *p)
+{
+    u32 v;
+    mcpy(&v, p, sizeof(u32));
+    return v;
+}
+
+static inline void vfx_heat_half_st(u8 *p, u64 v)
+{
+    u32 w = (u32)v;
+    mcpy(p, &w, sizeof(u32));
+}
+
+// shifts a row of nb bytes right by s pixels, repeating the leftmost pixel
+static void vfx_heat_row_shr(u8 *row, i32 nb, i32 s)
+{
+    assert((nb & 3) == 0);
+    u64 m_lo = VFX_HEAT_BYTES_LO(s);
+    u64 fill = (row[0] & 0x80) ? 0xFF : 0;
+    i32 s_hi = 8 - s;
+    i32 i    = nb & ~7;
+
+    // right to left so the lane to the left is still unshifted
+    u64 v = i ? vfx_heat_lane_ld(&row[i - 8]) : fill << 56;
+    if (nb & 4) { // trailing half lane
+        u64 h = vfx_heat_half_ld(&row[i]);
+        u64 l = (h << 8) | (v >> 56);
+        vfx_heat_half_st(&row[i], ((h >> s) & m_lo) | ((l << s_hi) & ~m_lo));
+    }
+    for (i -= 8; 0 <= i; i -= 8) {
+        u64 n = i ? vfx_heat_lane_ld(&row[i - 8]) : fill << 56;
+        u64 l = (v << 8) | (n >> 56);
+        vfx_heat_lane_st(&row[i], ((v >> s) & m_lo) | ((l << s_hi) & ~m_lo));
+        v = n;
+    }
+}
+
+// shifts a row of nb bytes left by s pixels, repeating the rightmost
+// visible pixel; bytes past the visible nb_vis are padding
+static void vfx_heat_row_shl(u8 *row, i32 nb, i32 nb_vis, i32 s)
+{
+    assert((nb & 3) == 0);
+    u64 m_hi = ~VFX_HEAT_BYTES_LO(8 - s);
+    u64 fill = (row[nb_vis - 1] & 1) ? 0xFF : 0;
+    i32 s_lo = 8 - s;
+    i32 n8   = nb & ~7;
+    mset(&row[nb_vis], (i32)fill, nb - nb_vis);
+
+    // left to right so the lane to the right is still unshifted
+    u64 v = n8 ? vfx_heat_lane_ld(row) : 0;
+    for (i32 i = 0; i < n8; i += 8) {
+        u64 n = fill;
+        if (i + 8 < n8) {
+            n = vfx_heat_lane_ld(&row[i + 8]);
+        } else if (nb & 4) {
+            n = vfx_heat_half_ld(&row[i + 8]);
+        }
+        u64 r = (v >> 8) | (n << 56);
+        vfx_heat_lane_st(&row[i], ((v << s) & m_hi) | ((r >> s_lo) & ~m_hi));
+        v = n;
+    }
+    if (nb & 4) { // trailing half lane
+        u64 h = n8 ? v : vfx_heat_half_ld(row);
+        u64 r = (h >> 8) | (fill << 24);
+        vfx_heat_half_st(&row[n8], ((h << s) & m_hi) | ((r >> s_lo) & ~m_hi));
+    }
 }
 
 void vfx_area_heat_draw(g_s *g, v2_i32 cam)
 {
     vfx_area_heat_s *fx = (vfx_area_heat_s *)g->vfx_area_mem;
     tex_s            t  = asset_tex(0);
+    i32              nb = t.wword * 4;
 
     // shift scanlines left and right
     for (i32 y = 0; y < PLTF_DISPLAY_H; y++) {
-        i32 a = (sin_q16(fx->tick + y * 3000) * 2) / 65536;
-        a &= ~1;
-
-        if (0 < a) { // shift scanline right
-            i32  sh1 = +a;
-            i32  sh2 = 32 - a;
-            u32 *p   = &t.px[t.wword - 1 + y * t.wword];
-            for (i32 x = 1; x < PLTF_DISPLAY_WWORDS; x++, p--) {
-                *p = bswap32((bswap32(*(p + 0)) >> sh1) |
-                             (bswap32(*(p - 1)) << sh2));
-            }
-            u32 pt    = bswap32(*(p + 0));
-            u32 p_rem = pt >> sh1;
-            if (pt & ((u32)1 << 31)) {
-                p_rem |= 0xFFFFFFFF << sh2;
-            }
-            *p = bswap32(p_rem);
-        } else if (a < 0) { // shift scanline left
-            i32  sh1 = -a;
-            i32  sh2 = 32 + a;
-            u32 *p   = &t.px[0 + y * t.wword];
-            for (i32 x = 1; x < PLTF_DISPLAY_WWORDS; x++, p++) {
-                *p = bswap32((bswap32(*(p + 0)) << sh1) |
-                             (bswap32(*(p + 1)) >> sh2));
-            }
-            // have to mask here because the screen area stop halfway
-            // throughout the word
-            u32 pt    = bswap32(*(p + 0)) & 0xFFFF0000;
-            u32 p_rem = pt << sh1;
-            if (pt & ((u32)1 << 16)) {
-                p_rem |= 0xFFFFFFFF >> (sh2 - 16);
-            }
-            *p = bswap32(p_rem);
+        i32  a   = fx->shift[y];
+        u8  *row = (u8 *)&t.px[y * t.wword];
+
+        if (0 < a) {
+            vfx_heat_row_shr(row, nb, +a);
+        } else if (a < 0) {
+            vfx_heat_row_shl(row, nb, PLTF_DISPLAY_W >> 3, -a);
         }
     }
-}
\ No newline at end of file
+}
@@ -4,10 +4,30 @@
 
 #include "game.h"
 
+// index of the first blade with pos.x >= x
+static u32 grass_lower_bound(g_s *g, i32 x)
+{
+    u32 lo = 0;
+    u32 hi = g->n_grass;
+    while (lo < hi) {
+        u32 mid = (lo + hi) >> 1;
+        if (g->grass[mid].pos.x < x) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 void grass_put(g_s *g, i32 tx, i32 ty)
 {
     if (g->n_grass >= NUM_GRASS) return;
-    grass_s *gr = &g->grass[g->n_grass++];
+    // insert after all blades at the same x to keep the put order
+    u32 i = grass_lower_bound(g, tx * 16 + 1);
+    mmov(&g->grass[i + 1], &g->grass[i], sizeof(grass_s) * (g->n_grass - i));
+    g->n_grass++;
+    grass_s *gr = &g->grass[i];
     mclr(gr, sizeof(grass_s));
     gr->pos.x = tx * 16;
     gr->pos.y = ty * 16;
@@ -16,12 +36,20 @@ void grass_put(g_s *g, i32 tx, i32 ty)
 
 void grass_animate(g_s *g)
 {
-    obj_s *ohero = obj_get_owl(g);
-    for (u32 n = 0; n < g->n_grass; n++) {
+    // blades out of view are asleep and keep their state until
+    // they scroll back in
+    rec_i32 camr = {g->cam_center.x - CAM_WH - 32, g->cam_center.y - CAM_HH - 32, CAM_W + 64, CAM_H + 64};
+    obj_s  *ohero = obj_get_owl(g);
+    rec_i32 rhero = ohero ? obj_aabb(ohero) : (rec_i32){0};
+
+    for (u32 n = grass_lower_bound(g, camr.x - 15); n < g->n_grass; n++) {
         grass_s *gr = &g->grass[n];
-        rec_i32  r  = {gr->pos.x, gr->pos.y, 16, 16};
+        if (camr.x + camr.w <= gr->pos.x) break;
 
-        if (ohero && overlap_rec(r, obj_aabb(ohero))) {
+        rec_i32 r = {gr->pos.x, gr->pos.y, 16, 16};
+        if (!overlap_rec(r, camr)) continue;
+
+        if (ohero && overlap_rec(r, rhero)) {
             gr->v_q8 += ohero->v_q12.x >> 4;
         }
 
@@ -37,36 +65,42 @@ void grass_draw(g_s *g, rec_i32 camrec, v2_i32 camoffset)
     gfx_ctx_s ctx     = gfx_ctx_display();
     texrec_s  trgrass = {0};
     trgrass.t         = asset_tex(TEXID_PLANTS);
+    trgrass.x         = 8;
+    trgrass.w         = 16;
+    trgrass.h         = 16;
 
-    for (u32 n = 0; n < g->n_grass; n++) {
+    for (u32 n = grass_lower_bound(g, camrec.x - 23); n < g->n_grass; n++) {
         grass_s *gr     = &g->grass[n];
         rec_i32  rgrass = {gr->pos.x - 8, gr->pos.y - 8, 32, 32};
+        if (camrec.x + camrec.w + 8 <= gr->pos.x) break;
         if (!overlap_rec(rgrass, camrec)) continue;
 
         v2_i32 pos = v2_i32_add(gr->pos, camoffset);
-
-        for (i32 i = 0; i < 16; i++) {
-            v2_i32 p = pos;
-            p.y += i;
-            p.x += (gr->x_q8 * (15 - i)) >> 8; // shear
-            trgrass.x = 0 + 8;
-            trgrass.y = i + gr->type * 16;
-            trgrass.w = 16;
-            trgrass.h = 1;
-            gfx_spr(ctx, trgrass, p, 0, 0);
-        }
+        trgrass.y  = gr->type * 16;
+        gfx_spr_shear_x(ctx, trgrass, pos, gr->x_q8, 0);
     }
 }
 
 void deco_verlet_animate_single(g_s *g, deco_verlet_s *d);
 
+// conservative bounds of a strand in q6: no point can be further
+// away from the anchor than the (stretched) strand length
+static rec_i32 deco_verlet_reach_q6(deco_verlet_s *d)
+{
+    i32     l = (i32)d->n_pt * d->dist * 2;
+    rec_i32 r = {(d->pos.x << 6) - l, (d->pos.y << 6) - l, l * 2 + 1, l * 2 + 1};
+    return r;
+}
+
 void deco_verlet_obj_collision(g_s *g, obj_s *o, i32 r)
 {
-    v2_i32 po = v2_i32_shl(obj_pos_center(o), 6);
-    i32    r2 = pow2_i32(r);
+    v2_i32  po = v2_i32_shl(obj_pos_center(o), 6);
+    i32     r2 = pow2_i32(r);
+    rec_i32 ro = {po.x - r, po.y - r, r * 2 + 1, r * 2 + 1};
 
     for (u32 n = 0; n < g->n_deco_verlet; n++) {
         deco_verlet_s *d = &g->deco_verlet[n];
+        if (!overlap_rec(ro, deco_verlet_reach_q6(d))) continue;
 
         v2_i32 p = v2_i32_shl(d->pos, 6);
         for (u32 i = 1; i < d->n_pt; i++) {
@@ -79,14 +113,24 @@ void deco_verlet_obj_collision(g_s *g, obj_s *o, i32 r)
             dt    = v2_i32_add(dt, po);
             dt    = v2_i32_sub(dt, p);
             pt->p = v2_i16_from_i32(dt);
+
+            d->sleeping      = 0;
+            d->ticks_settled = 0;
         }
     }
 }
 
 void deco_verlet_animate(g_s *g)
 {
+    rec_i32 camr = {(g->cam_center.x - CAM_WH - 32) << 6,
+                    (g->cam_center.y - CAM_HH - 32) << 6,
+                    (CAM_W + 64) << 6,
+                    (CAM_H + 64) << 6};
+
     for (u32 n = 0; n < g->n_deco_verlet; n++) {
         deco_verlet_s *d = &g->deco_verlet[n];
+        // off-screen strands are frozen mid swing until back in view
+        if (d->sleeping || !overlap_rec(camr, deco_verlet_reach_q6(d))) continue;
         deco_verlet_animate_single(g, d);
     }
 
@@ -117,11 +161,14 @@ void deco_verlet_animate_single(g_s *g, deco_verlet_s *d)
             i32               lensq = v2_i16_lensq(dt);
 
             if (lensq <= r2) continue;
-            i32 len = (i32)(sqrt_f32((f32)lensq) + .5f);
-            i32 ll  = d->dist + ((len - d->dist) >> 1);
-
-            v2_i16 vdt = {div_rounded_i32((dt.x * ll), len),
-                          div_rounded_i32((dt.y * ll), len)};
+            // both points move half of the excess towards each other:
+            // vdt = dt * (len + dist) / (2 * len) = dt * (1 + f) / 2
+            // with f = dist / len in Q14
+            i32 f = (i32)(((u64)d->dist * rsqrt_appr_q31_u32((u32)lensq)) >> 17);
+            i32 q = (1 << 14) + f;
+
+            v2_i16 vdt = {(dt.x * q + (1 << 14)) >> 15,
+                          (dt.y * q + (1 << 14)) >> 15};
             v2_i16 p1  = pt1->p;
             v2_i16 p2  = pt2->p;
             pt1->p     = v2_i16_add(p2, vdt);
@@ -134,6 +181,21 @@ void deco_verlet_animate_single(g_s *g, deco_verlet_s *d)
             d->pt[d->n_pt - 1].p.y = d->pos_2.y;
         }
     }
+
+    // fall asleep once no point moved noticeably for a while
+    i32 v_max = 0;
+    for (u32 n = 1; n < d->n_pt; n++) {
+        v2_i16 v = v2_i16_sub(d->pt[n].p, d->pt[n].pp);
+        v_max    = max_i32(v_max, max_i32(abs_i32(v.x), abs_i32(v.y)));
+    }
+    if (DECO_VERLET_SLEEP_Q6 < v_max) {
+        d->ticks_settled = 0;
+    } else if (DECO_VERLET_SLEEP_TICKS <= ++d->ticks_settled) {
+        d->sleeping = 1;
+        for (u32 n = 1; n < d->n_pt; n++) {
+            d->pt[n].pp = d->pt[n].p; // drop residual velocity
+        }
+    }
 }
 
 void deco_verlet_draw(g_s *g, v2_i32 cam)
@@ -12,6 +12,11 @@
 #define NUM_DECO_VERLET_PT 16
 #define NUM_DECO_VERLET    64
 
+// a strand falls asleep after moving at most this much (q6) per
+// update for a number of updates; the hero pushing it wakes it up
+#define DECO_VERLET_SLEEP_Q6    1
+#define DECO_VERLET_SLEEP_TICKS 16
+
 typedef struct {
     v2_i16 p;  // in q6, relative to origin
     v2_i16 pp; // in q6, relative to origin
@@ -20,6 +25,8 @@ typedef struct {
 typedef struct {
     u8               n_pt;
     u8               n_it;
+    b8               sleeping;
+    u8               ticks_settled;
     u16              dist;
     v2_i16           grav;
     v2_i32           pos;
@@ -28,6 +35,8 @@ typedef struct {
     deco_verlet_pt_s pt[NUM_DECO_VERLET_PT]; // in q6, relative to origin
 } deco_verlet_s;
 
+// kept sorted by x so animation and drawing only visit the blades
+// in a horizontal window; blades outside of it are asleep
 typedef struct {
     v2_i32 pos;
     i32    type;
@@ -155,42 +155,34 @@ static void wire_points_in_tris(g_s *g, tri_i32 t1, tri_i32 t2, wire_pts_s *pts)
     assert(v2_i32_crs(v2_i32_sub(t1.p[2], t1.p[0]), v2_i32_sub(t1.p[1], t1.p[0])) != 0);
     assert(v2_i32_crs(v2_i32_sub(t2.p[2], t2.p[0]), v2_i32_sub(t2.p[1], t2.p[0])) != 0);
 
-    v2_i32            pmin1  = v2_min(t1.p[0], v2_min(t1.p[1], t1.p[2]));
-    v2_i32            pmin2  = v2_min(t2.p[0], v2_min(t2.p[1], t2.p[2]));
-    v2_i32            pmax1  = v2_max(t1.p[0], v2_max(t1.p[1], t1.p[2]));
-    v2_i32            pmax2  = v2_max(t2.p[0], v2_max(t2.p[1], t2.p[2]));
-    tile_map_bounds_s bounds = tile_map_bounds_pts(g,
-                                                   v2_min(pmin1, pmin2),
-                                                   v2_max(pmax1, pmax2));
-
-    for (i32 y = bounds.y1; y <= bounds.y2; y++) {
-        for (i32 x = bounds.x1; x <= bounds.x2; x++) {
-            i32 t = g->tiles[x + y * g->tiles_x].shape;
-            if (!(0 < t && t < NUM_TILE_SHAPES)) continue;
-            v2_i32 pos = {x << 4, y << 4};
-            if (TILE_IS_BLOCK(t)) {
-                v2_i32  p[4];
-                rec_i32 rblock = {pos.x, pos.y, 16, 16};
-                points_from_rec(rblock, p);
-                wire_convex_pt_s v0 = {p[0], p[1], p[2]};
-                wire_convex_pt_s v1 = {p[1], p[2], p[3]};
-                wire_convex_pt_s v2 = {p[2], p[3], p[0]};
-                wire_convex_pt_s v3 = {p[3], p[0], p[1]};
-                wire_try_add_point_in_tri(v0, t1, t2, pts);
-                wire_try_add_point_in_tri(v1, t1, t2, pts);
-                wire_try_add_point_in_tri(v2, t1, t2, pts);
-                wire_try_add_point_in_tri(v3, t1, t2, pts);
-            }
-            if (TILE_IS_SLOPE_45(t)) {
-                tri_i32 tr = translate_tri(((tri_i32 *)g_tile_tris)[t], pos);
-                v2_i32 *p  = tr.p;
-
-                wire_convex_pt_s v0 = {p[0], p[1], p[2]};
-                wire_convex_pt_s v1 = {p[1], p[2], p[0]};
-                wire_convex_pt_s v2 = {p[2], p[0], p[1]};
-                wire_try_add_point_in_tri(v0, t1, t2, pts);
-                wire_try_add_point_in_tri(v1, t1, t2, pts);
-                wire_try_add_point_in_tri(v2, t1, t2, pts);
+    v2_i32 pmin1 = v2_min(t1.p[0], v2_min(t1.p[1], t1.p[2]));
+    v2_i32 pmin2 = v2_min(t2.p[0], v2_min(t2.p[1], t2.p[2]));
+    v2_i32 pmax1 = v2_max(t1.p[0], v2_max(t1.p[1], t1.p[2]));
+    v2_i32 pmax2 = v2_max(t2.p[0], v2_max(t2.p[1], t2.p[2]));
+    v2_i32 pmin  = v2_max(pmin1, pmin2); // a point needs to be in both
+    v2_i32 pmax  = v2_min(pmax1, pmax2);
+
+    // cached convex terrain corners on the vertex grid
+    i32 vx1 = max_i32((pmin.x + 15) >> 4, 0);
+    i32 vy1 = max_i32((pmin.y + 15) >> 4, 0);
+    i32 vx2 = min_i32(pmax.x >> 4, g->tiles_x);
+    i32 vy2 = min_i32(pmax.y >> 4, g->tiles_y);
+    for (i32 cy = vy1 >> TILE_CORNERS_CHUNK_SHIFT; cy <= (vy2 >> TILE_CORNERS_CHUNK_SHIFT); cy++) {
+        for (i32 cx = vx1 >> TILE_CORNERS_CHUNK_SHIFT; cx <= (vx2 >> TILE_CORNERS_CHUNK_SHIFT); cx++) {
+            u64 m = tile_map_corners_chunk(g, cx, cy);
+            for (i32 b = 0; m; b++, m >>= 1) {
+                if (!(m & 1)) continue;
+
+                i32 vx = (cx << TILE_CORNERS_CHUNK_SHIFT) + (b & 7);
+                i32 vy = (cy << TILE_CORNERS_CHUNK_SHIFT) + (b >> 3);
+                if (vx < vx1 || vx2 < vx || vy < vy1 || vy2 < vy) continue;
+
+                tile_corner_s c[4];
+                i32           n_c = tile_map_corners_at(g, vx, vy, c);
+                for (i32 i = 0; i < n_c; i++) {
+                    wire_convex_pt_s v = {c[i].p, c[i].u, c[i].v};
+                    wire_try_add_point_in_tri(v, t1, t2, pts);
+                }
             }
         }
     }